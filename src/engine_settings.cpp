@@ -0,0 +1,150 @@
+#include "engine_settings.h"
+
+#include <stdexcept>
+
+namespace owl
+{
+    namespace
+    {
+        VkPresentModeKHR parse_presentation_mode(const std::string& value)
+        {
+            if (value == "immediate")
+                return VK_PRESENT_MODE_IMMEDIATE_KHR;
+            if (value == "mailbox")
+                return VK_PRESENT_MODE_MAILBOX_KHR;
+            if (value == "fifo")
+                return VK_PRESENT_MODE_FIFO_KHR;
+            if (value == "fifo_relaxed")
+                return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+
+            throw std::invalid_argument("Unknown presentation mode: " + value);
+        }
+
+        descriptor_binding_mode parse_binding_mode(const std::string& value)
+        {
+            if (value == "sets")
+                return descriptor_binding_mode::descriptor_sets;
+            if (value == "templates")
+                return descriptor_binding_mode::update_templates;
+            if (value == "push")
+                return descriptor_binding_mode::push_descriptors;
+
+            throw std::invalid_argument("Unknown descriptor binding mode: " + value);
+        }
+
+        uint32_t parse_count(const std::string& value)
+        {
+            try
+            {
+                return static_cast<uint32_t>(std::stoul(value));
+            }
+            catch (const std::exception&)
+            {
+                throw std::invalid_argument("Invalid count: " + value);
+            }
+        }
+    } // namespace
+
+    engine_settings engine_settings::low_latency()
+    {
+        engine_settings settings;
+        settings.presentation_mode = VK_PRESENT_MODE_MAILBOX_KHR;
+        settings.frames_in_flight = 1;
+        settings.swapchain_images_count = 2;
+
+        return settings;
+    }
+
+    void engine_settings::validate() const
+    {
+        if (frames_in_flight < min_frames_in_flight || frames_in_flight > max_frames_in_flight)
+            throw std::invalid_argument("Frames in flight must be between 1 and 4.");
+
+        if (presentation_mode != VK_PRESENT_MODE_IMMEDIATE_KHR && presentation_mode != VK_PRESENT_MODE_MAILBOX_KHR &&
+            presentation_mode != VK_PRESENT_MODE_FIFO_KHR && presentation_mode != VK_PRESENT_MODE_FIFO_RELAXED_KHR)
+            throw std::invalid_argument("Unsupported presentation mode.");
+    }
+
+    engine_settings parse_engine_settings(const std::vector<std::string>& arguments)
+    {
+        engine_settings settings;
+
+        // the preset is applied first so explicit options can refine it
+        for (const auto& argument : arguments)
+        {
+            if (argument == "--low-latency")
+                settings = engine_settings::low_latency();
+        }
+
+        for (const auto& argument : arguments)
+        {
+            auto separator = argument.find('=');
+            auto name = argument.substr(0, separator);
+            auto value = separator != std::string::npos ? argument.substr(separator + 1) : std::string();
+
+            if (name == "--low-latency")
+                continue;
+            else if (name == "--present-mode")
+                settings.presentation_mode = parse_presentation_mode(value);
+            else if (name == "--frames-in-flight")
+                settings.frames_in_flight = parse_count(value);
+            else if (name == "--swapchain-images")
+                settings.swapchain_images_count = parse_count(value);
+            else if (name == "--concurrent-swapchain")
+                settings.is_concurrent_swapchain_sharing_enabled = true;
+            else if (name == "--measure-latency")
+                settings.is_latency_measurement_enabled = true;
+            else if (name == "--latency-log")
+            {
+                settings.latency_log_path = value;
+                settings.is_latency_measurement_enabled = true;
+            }
+            else if (name == "--max-fps")
+                settings.max_frame_rate = parse_count(value);
+            else if (name == "--on-demand")
+                settings.is_on_demand_rendering_enabled = true;
+            else if (name == "--descriptor-binding")
+                settings.binding_mode = parse_binding_mode(value);
+            else if (name == "--bindless")
+                settings.is_bindless_enabled = true;
+            else
+                throw std::invalid_argument("Unknown option: " + argument);
+        }
+
+        settings.validate();
+
+        return settings;
+    }
+
+    std::string to_string(VkPresentModeKHR presentation_mode)
+    {
+        switch (presentation_mode)
+        {
+        case VK_PRESENT_MODE_IMMEDIATE_KHR:
+            return "immediate";
+        case VK_PRESENT_MODE_MAILBOX_KHR:
+            return "mailbox";
+        case VK_PRESENT_MODE_FIFO_KHR:
+            return "fifo";
+        case VK_PRESENT_MODE_FIFO_RELAXED_KHR:
+            return "fifo_relaxed";
+        default:
+            return "unknown";
+        }
+    }
+
+    std::string to_string(descriptor_binding_mode binding_mode)
+    {
+        switch (binding_mode)
+        {
+        case descriptor_binding_mode::descriptor_sets:
+            return "descriptor sets";
+        case descriptor_binding_mode::update_templates:
+            return "update templates";
+        case descriptor_binding_mode::push_descriptors:
+            return "push descriptors";
+        default:
+            return "unknown";
+        }
+    }
+} // namespace owl
\ No newline at end of file
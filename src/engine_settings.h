@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace owl
+{
+    enum class descriptor_binding_mode
+    {
+        // one preallocated set per swapchain image, written with a write struct per binding
+        descriptor_sets,
+        // the same sets, each written from one packed struct through an update template
+        update_templates,
+        // no sets, the bindings of each draw are recorded straight into the command buffer
+        push_descriptors
+    };
+
+    struct engine_settings
+    {
+        static constexpr uint32_t min_frames_in_flight = 1;
+        static constexpr uint32_t max_frames_in_flight = 4;
+
+        // immediate, mailbox, fifo or fifo relaxed; fifo is used when the preferred mode is not supported
+        VkPresentModeKHR presentation_mode = VK_PRESENT_MODE_MAILBOX_KHR;
+        uint32_t frames_in_flight = 2;
+        // 0 lets the engine pick one image more than the surface minimum
+        uint32_t swapchain_images_count = 0;
+        // when graphics and presentation families differ, share swapchain images concurrently instead of transferring ownership
+        bool is_concurrent_swapchain_sharing_enabled = false;
+        bool is_latency_measurement_enabled = false;
+        // per frame latencies of the last frames are written there on exit, measuring latency is implied
+        std::string latency_log_path;
+        // 0 leaves the frame rate to the presentation mode
+        uint32_t max_frame_rate = 0;
+        // frames are only rendered when the scene changed or the window needs repainting
+        bool is_on_demand_rendering_enabled = false;
+        // falls back to update templates, then to plain descriptor sets, when the device lacks the extensions; only read when
+        // the engine is initialized
+        descriptor_binding_mode binding_mode = descriptor_binding_mode::push_descriptors;
+        // fragment shaders pick their texture from a descriptor indexing table by material id; without vulkan 1.2 descriptor
+        // indexing the engine keeps binding the texture per draw; only read when the engine is initialized
+        bool is_bindless_enabled = false;
+
+        // a single frame in flight and the smallest swapchain, so at most one frame is queued behind the displayed one
+        static engine_settings low_latency();
+
+        void validate() const;
+    };
+
+    engine_settings parse_engine_settings(const std::vector<std::string>& arguments);
+    std::string to_string(VkPresentModeKHR presentation_mode);
+    std::string to_string(descriptor_binding_mode binding_mode);
+} // namespace owl
\ No newline at end of file
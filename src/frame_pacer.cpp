@@ -0,0 +1,94 @@
+#include "frame_pacer.h"
+
+#include <thread>
+
+namespace owl
+{
+    frame_pacer::frame_pacer(uint32_t max_frame_rate, bool is_on_demand)
+        : _frame_period(clock::duration::zero())
+        , _is_on_demand(is_on_demand)
+        , _start_time(clock::now())
+    {
+        if (max_frame_rate > 0)
+            _frame_period = std::chrono::duration_cast<clock::duration>(std::chrono::seconds(1)) / max_frame_rate;
+    }
+
+    bool frame_pacer::begin_frame(uint64_t content_version)
+    {
+        auto now = clock::now();
+
+        if (_is_on_demand)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (!_is_redraw_requested && content_version == _rendered_version)
+            {
+                // the presented image is still up to date, the timeout bounds how late a stop request is noticed
+                auto idle_period = _frame_period.count() > 0 ? _frame_period : clock::duration(default_idle_period);
+                _change_condition.wait_for(lock, idle_period, [this]() { return _is_notified || _is_redraw_requested; });
+                _is_notified = false;
+
+                _statistics.skipped_frames_count++;
+                _statistics.idle_time += std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - now);
+                return false;
+            }
+
+            _is_redraw_requested = false;
+        }
+
+        _rendered_version = content_version;
+        _frame_start_time = now;
+
+        return true;
+    }
+
+    void frame_pacer::end_frame()
+    {
+        auto now = clock::now();
+        _statistics.rendered_frames_count++;
+        _statistics.render_time += std::chrono::duration_cast<std::chrono::microseconds>(now - _frame_start_time);
+
+        if (_frame_period.count() == 0)
+            return;
+
+        auto next_frame_time = _frame_start_time + _frame_period;
+        if (next_frame_time <= now)
+            return;
+
+        std::this_thread::sleep_until(next_frame_time);
+        _statistics.limiter_wait_time += std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - now);
+    }
+
+    void frame_pacer::request_redraw()
+    {
+        if (!_is_on_demand)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _is_redraw_requested = true;
+        }
+
+        _change_condition.notify_one();
+    }
+
+    void frame_pacer::notify()
+    {
+        if (!_is_on_demand)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _is_notified = true;
+        }
+
+        _change_condition.notify_one();
+    }
+
+    frame_pacing_statistics frame_pacer::get_statistics() const
+    {
+        auto statistics = _statistics;
+        statistics.elapsed_time = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - _start_time);
+
+        return statistics;
+    }
+} // namespace owl
\ No newline at end of file
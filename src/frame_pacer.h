@@ -0,0 +1,60 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace owl
+{
+    struct frame_pacing_statistics
+    {
+        uint64_t rendered_frames_count = 0;
+        uint64_t skipped_frames_count = 0;
+        std::chrono::microseconds elapsed_time{0};
+        std::chrono::microseconds render_time{0};
+        std::chrono::microseconds limiter_wait_time{0};
+        std::chrono::microseconds idle_time{0};
+    };
+
+    // paces the render thread: an optional frame rate cap, and an on demand mode where frames whose content did not change
+    // are skipped, the render thread sleeping until the simulation publishes a change or a redraw is requested
+    class frame_pacer
+    {
+    public:
+        // the period an on demand render thread sleeps for when nothing changed and the frame rate is not capped
+        static constexpr std::chrono::microseconds default_idle_period{16667};
+
+        frame_pacer(uint32_t max_frame_rate, bool is_on_demand);
+
+        bool is_on_demand() const { return _is_on_demand; }
+        bool is_pacing() const { return _is_on_demand || _frame_period.count() > 0; }
+
+        // render thread only; returns false when the frame can be skipped, after having waited up to one period for a change
+        bool begin_frame(uint64_t content_version);
+        void end_frame();
+
+        // any thread; forces the next frame to be rendered, for events that invalidate the presented image
+        void request_redraw();
+        // any thread; wakes an idle render thread so it checks the latest content version
+        void notify();
+
+        frame_pacing_statistics get_statistics() const;
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        clock::duration _frame_period;
+        bool _is_on_demand;
+
+        std::mutex _mutex;
+        std::condition_variable _change_condition;
+        bool _is_redraw_requested = true;
+        bool _is_notified = false;
+
+        uint64_t _rendered_version = 0;
+        clock::time_point _start_time;
+        clock::time_point _frame_start_time;
+        frame_pacing_statistics _statistics;
+    };
+} // namespace owl
\ No newline at end of file
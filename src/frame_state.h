@@ -0,0 +1,25 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+#include <glm/mat4x4.hpp>
+
+namespace owl
+{
+    // immutable snapshot of everything the render thread needs from the simulation for one frame
+    struct frame_state
+    {
+        uint64_t sequence = 0;
+        // only changes when the rendered content does, so identical snapshots can be skipped
+        uint64_t content_version = 0;
+        float time = 0.0f;
+        glm::mat4 model{1.0f};
+        glm::mat4 view{1.0f};
+        std::chrono::steady_clock::time_point input_time;
+    };
+
+    // returns the newest published snapshot; the engine calls it as late as possible before submitting a frame
+    using frame_state_latch = std::function<const frame_state&()>;
+} // namespace owl
\ No newline at end of file
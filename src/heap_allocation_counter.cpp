@@ -0,0 +1,46 @@
+#include "heap_allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<size_t> heap_allocations_count{0};
+}
+
+namespace owl
+{
+    bool is_heap_allocation_counting_enabled()
+    {
+#ifdef OWL_COUNT_HEAP_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    size_t get_heap_allocations_count() { return heap_allocations_count.load(std::memory_order_relaxed); }
+} // namespace owl
+
+#ifdef OWL_COUNT_HEAP_ALLOCATIONS
+void* operator new(size_t size)
+{
+    heap_allocations_count.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* memory = std::malloc(size != 0 ? size : 1))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+
+void operator delete[](void* memory) noexcept { std::free(memory); }
+
+void operator delete(void* memory, size_t size) noexcept { std::free(memory); }
+
+void operator delete[](void* memory, size_t size) noexcept { std::free(memory); }
+#endif
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstddef>
+
+namespace owl
+{
+    // counts global operator new calls when the engine is built with OWL_COUNT_HEAP_ALLOCATIONS, so a steady state frame can be
+    // checked for general heap allocations; without it the count stays at zero
+    bool is_heap_allocation_counting_enabled();
+    size_t get_heap_allocations_count();
+} // namespace owl
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "latency_tracker.h"
+
+#include <algorithm>
+
+namespace owl
+{
+    namespace
+    {
+        template <typename TSample, typename TProjection>
+        void compute_statistics(const std::array<TSample, latency_tracker::window_size>& samples,
+                                size_t samples_count,
+                                TProjection&& projection,
+                                std::chrono::microseconds& average,
+                                std::chrono::microseconds& max)
+        {
+            size_t count = std::min(samples_count, latency_tracker::window_size);
+            if (count == 0)
+                return;
+
+            std::chrono::microseconds total{0};
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto latency = projection(samples[i]);
+                total += latency;
+                max = std::max(max, latency);
+            }
+
+            average = total / static_cast<int64_t>(count);
+        }
+    } // namespace
+
+    void latency_tracker::reset(size_t frames_in_flight)
+    {
+        _frames.assign(frames_in_flight, frame_timing{});
+        _frame_samples_count = 0;
+        _completion_samples_count = 0;
+    }
+
+    void latency_tracker::sample_input(uint64_t sequence, std::chrono::steady_clock::time_point input_time)
+    {
+        _input_time = input_time;
+        _pending_sample = frame_latency_sample{};
+        _pending_sample.sequence = sequence;
+    }
+
+    void latency_tracker::record_submit()
+    {
+        _pending_sample.submit_latency = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - _input_time);
+    }
+
+    void latency_tracker::record_present(size_t frame)
+    {
+        // the frame slot keeps its input time until the cpu observes the frame as complete
+        _frames[frame].input_time = _input_time;
+        _frames[frame].is_pending = true;
+
+        _pending_sample.present_latency = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - _input_time);
+        _frame_samples[_frame_samples_count++ % window_size] = _pending_sample;
+    }
+
+    void latency_tracker::record_completion(size_t frame)
+    {
+        if (!_frames[frame].is_pending)
+            return;
+
+        auto latency = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - _frames[frame].input_time);
+        _completion_latencies[_completion_samples_count++ % window_size] = latency;
+        _frames[frame].is_pending = false;
+    }
+
+    latency_statistics latency_tracker::get_statistics() const
+    {
+        auto submit_latency = [](const frame_latency_sample& sample) { return sample.submit_latency; };
+        auto present_latency = [](const frame_latency_sample& sample) { return sample.present_latency; };
+        auto completion_latency = [](std::chrono::microseconds latency) { return latency; };
+
+        latency_statistics statistics;
+        statistics.samples_count = std::min(_completion_samples_count, window_size);
+        compute_statistics(
+            _frame_samples, _frame_samples_count, submit_latency, statistics.average_submit_latency, statistics.max_submit_latency);
+        compute_statistics(
+            _frame_samples, _frame_samples_count, present_latency, statistics.average_present_latency, statistics.max_present_latency);
+        compute_statistics(_completion_latencies,
+                           _completion_samples_count,
+                           completion_latency,
+                           statistics.average_completion_latency,
+                           statistics.max_completion_latency);
+
+        return statistics;
+    }
+
+    void latency_tracker::write_frame_samples(std::ostream& stream) const
+    {
+        stream << "sequence,sample_to_submit_us,sample_to_present_us" << std::endl;
+
+        size_t count = std::min(_frame_samples_count, window_size);
+        for (size_t i = _frame_samples_count - count; i < _frame_samples_count; ++i)
+        {
+            const auto& sample = _frame_samples[i % window_size];
+            stream << sample.sequence << "," << sample.submit_latency.count() << "," << sample.present_latency.count() << std::endl;
+        }
+    }
+} // namespace owl
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace owl
+{
+    struct latency_statistics
+    {
+        size_t samples_count = 0;
+        std::chrono::microseconds average_submit_latency{0};
+        std::chrono::microseconds max_submit_latency{0};
+        std::chrono::microseconds average_present_latency{0};
+        std::chrono::microseconds max_present_latency{0};
+        std::chrono::microseconds average_completion_latency{0};
+        std::chrono::microseconds max_completion_latency{0};
+    };
+
+    struct frame_latency_sample
+    {
+        uint64_t sequence = 0;
+        std::chrono::microseconds submit_latency{0};
+        std::chrono::microseconds present_latency{0};
+    };
+
+    // measures, per frame slot, the time from input sampling to the submission, to the present call and to the moment the cpu
+    // observes the frame's gpu work as complete; the latter is an upper bound since completion is only observed when the slot is
+    // waited on again
+    class latency_tracker
+    {
+    public:
+        static constexpr size_t window_size = 128;
+
+        void reset(size_t frames_in_flight);
+
+        void sample_input(uint64_t sequence, std::chrono::steady_clock::time_point input_time);
+        void record_submit();
+        void record_present(size_t frame);
+        void record_completion(size_t frame);
+
+        latency_statistics get_statistics() const;
+        // the most recent frames, oldest first, as comma separated values
+        void write_frame_samples(std::ostream& stream) const;
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        struct frame_timing
+        {
+            clock::time_point input_time;
+            bool is_pending = false;
+        };
+
+        std::vector<frame_timing> _frames;
+        clock::time_point _input_time;
+        frame_latency_sample _pending_sample;
+        std::array<frame_latency_sample, window_size> _frame_samples{};
+        std::array<std::chrono::microseconds, window_size> _completion_latencies{};
+        size_t _frame_samples_count = 0;
+        size_t _completion_samples_count = 0;
+    };
+} // namespace owl
\ No newline at end of file
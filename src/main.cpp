@@ -3,13 +3,64 @@
 #include <cstdlib>
 #include <exception>
 #include <iostream>
+#include <string>
+#include <vector>
 
-int main()
+int main(int argc, char** argv)
 {
     try
     {
-        owl::vulkan_window window(800, 600);
-        window.run();
+        std::vector<std::string> arguments;
+        uint32_t resizes_count = 0;
+        uint32_t sharing_benchmark_frames_count = 0;
+        uint32_t descriptor_benchmark_draws_count = 0;
+        uint32_t defragmentation_soak_frames_count = 0;
+        uint32_t allocation_benchmark_allocations_count = 0;
+        uint32_t upload_benchmark_uploads_count = 0;
+
+        const std::string resize_storm_option = "--resize-storm=";
+        const std::string sharing_benchmark_option = "--sharing-benchmark=";
+        const std::string descriptor_benchmark_option = "--descriptor-benchmark=";
+        const std::string defragmentation_soak_option = "--defragmentation-soak=";
+        const std::string allocation_benchmark_option = "--allocation-benchmark=";
+        const std::string upload_benchmark_option = "--upload-benchmark=";
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string argument = argv[i];
+            if (argument.rfind(resize_storm_option, 0) == 0)
+                resizes_count = static_cast<uint32_t>(std::stoul(argument.substr(resize_storm_option.size())));
+            else if (argument.rfind(sharing_benchmark_option, 0) == 0)
+                sharing_benchmark_frames_count = static_cast<uint32_t>(std::stoul(argument.substr(sharing_benchmark_option.size())));
+            else if (argument.rfind(descriptor_benchmark_option, 0) == 0)
+                descriptor_benchmark_draws_count =
+                    static_cast<uint32_t>(std::stoul(argument.substr(descriptor_benchmark_option.size())));
+            else if (argument.rfind(defragmentation_soak_option, 0) == 0)
+                defragmentation_soak_frames_count =
+                    static_cast<uint32_t>(std::stoul(argument.substr(defragmentation_soak_option.size())));
+            else if (argument.rfind(allocation_benchmark_option, 0) == 0)
+                allocation_benchmark_allocations_count =
+                    static_cast<uint32_t>(std::stoul(argument.substr(allocation_benchmark_option.size())));
+            else if (argument.rfind(upload_benchmark_option, 0) == 0)
+                upload_benchmark_uploads_count = static_cast<uint32_t>(std::stoul(argument.substr(upload_benchmark_option.size())));
+            else
+                arguments.push_back(argument);
+        }
+
+        owl::vulkan_window window(800, 600, owl::parse_engine_settings(arguments));
+        if (resizes_count > 0)
+            window.run_resize_storm(resizes_count);
+        else if (sharing_benchmark_frames_count > 0)
+            window.run_sharing_benchmark(sharing_benchmark_frames_count);
+        else if (descriptor_benchmark_draws_count > 0)
+            window.run_descriptor_benchmark(descriptor_benchmark_draws_count);
+        else if (defragmentation_soak_frames_count > 0)
+            window.run_defragmentation_soak(defragmentation_soak_frames_count);
+        else if (allocation_benchmark_allocations_count > 0)
+            window.run_allocation_benchmark(allocation_benchmark_allocations_count);
+        else if (upload_benchmark_uploads_count > 0)
+            window.run_upload_benchmark(upload_benchmark_uploads_count);
+        else
+            window.run();
     }
     catch (const std::exception& ex)
     {
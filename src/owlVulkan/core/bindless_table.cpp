@@ -0,0 +1,130 @@
+#include "bindless_table.h"
+
+#include <array>
+#include <stdexcept>
+
+#include "../helpers/vulkan_helpers.h"
+
+namespace owl::vulkan::core
+{
+    bindless_table::bindless_table(const std::shared_ptr<logical_device>& logical_device,
+                                   const sampler& sampler,
+                                   uint32_t max_textures,
+                                   uint32_t max_storage_buffers)
+        : _logical_device(logical_device)
+        , _max_textures(max_textures)
+        , _max_storage_buffers(max_storage_buffers)
+    {
+        if (!_logical_device->is_descriptor_indexing_enabled())
+            throw std::runtime_error("Bindless tables require descriptor indexing");
+
+        VkDescriptorSetLayoutBinding storage_buffers_binding_info{};
+        storage_buffers_binding_info.binding = storage_buffers_binding;
+        storage_buffers_binding_info.descriptorCount = max_storage_buffers;
+        storage_buffers_binding_info.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        storage_buffers_binding_info.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+        // every texture is sampled the same way, an immutable sampler needs no write
+        VkDescriptorSetLayoutBinding sampler_binding_info{};
+        sampler_binding_info.binding = sampler_binding;
+        sampler_binding_info.descriptorCount = 1;
+        sampler_binding_info.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+        sampler_binding_info.pImmutableSamplers = &sampler.get_vk_handle();
+        sampler_binding_info.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+        VkDescriptorSetLayoutBinding textures_binding_info{};
+        textures_binding_info.binding = textures_binding;
+        textures_binding_info.descriptorCount = max_textures;
+        textures_binding_info.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        textures_binding_info.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+        std::array<VkDescriptorSetLayoutBinding, 3> bindings = {storage_buffers_binding_info, sampler_binding_info, textures_binding_info};
+
+        VkDescriptorBindingFlags table_flags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                                               VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+        std::array<VkDescriptorBindingFlags, 3> binding_flags = {table_flags, 0, table_flags};
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfo binding_flags_info{};
+        binding_flags_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+        binding_flags_info.bindingCount = static_cast<uint32_t>(binding_flags.size());
+        binding_flags_info.pBindingFlags = binding_flags.data();
+
+        VkDescriptorSetLayoutCreateInfo layout_info{};
+        layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layout_info.pNext = &binding_flags_info;
+        layout_info.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+        layout_info.bindingCount = static_cast<uint32_t>(bindings.size());
+        layout_info.pBindings = bindings.data();
+
+        auto result = vkCreateDescriptorSetLayout(_logical_device->get_vk_handle(),
+                                                  &layout_info,
+                                                  _logical_device->get_allocation_callbacks(host_object_type::descriptor_set_layout),
+                                                  &_vk_descriptor_set_layout);
+        helpers::handle_result(result, "Failed to create bindless descriptor set layout");
+
+        std::vector<VkDescriptorPoolSize> pool_sizes = {{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, max_storage_buffers},
+                                                        {VK_DESCRIPTOR_TYPE_SAMPLER, 1},
+                                                        {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, max_textures}};
+        _pool = std::make_unique<descriptor_pool>(_logical_device, 1, pool_sizes, VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT);
+
+        result = _pool->try_allocate(_vk_descriptor_set_layout, _vk_handle);
+        helpers::handle_result(result, "Failed to allocate bindless descriptor set");
+    }
+
+    bindless_table::~bindless_table()
+    {
+        // the set goes away with its pool
+        _pool = nullptr;
+        vkDestroyDescriptorSetLayout(_logical_device->get_vk_handle(),
+                                     _vk_descriptor_set_layout,
+                                     _logical_device->get_allocation_callbacks(host_object_type::descriptor_set_layout));
+    }
+
+    uint32_t bindless_table::add_texture(const image_view& image_view)
+    {
+        if (_textures_count == _max_textures)
+            throw std::length_error("Bindless texture table is full");
+
+        VkDescriptorImageInfo image_info{};
+        image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        image_info.imageView = image_view.get_vk_handle();
+        image_info.sampler = VK_NULL_HANDLE;
+
+        VkWriteDescriptorSet descriptor_write{};
+        descriptor_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptor_write.dstSet = _vk_handle;
+        descriptor_write.dstBinding = textures_binding;
+        descriptor_write.dstArrayElement = _textures_count;
+        descriptor_write.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        descriptor_write.descriptorCount = 1;
+        descriptor_write.pImageInfo = &image_info;
+
+        vkUpdateDescriptorSets(_logical_device->get_vk_handle(), 1, &descriptor_write, 0, nullptr);
+
+        return _textures_count++;
+    }
+
+    uint32_t bindless_table::add_storage_buffer(const buffer& buffer)
+    {
+        if (_storage_buffers_count == _max_storage_buffers)
+            throw std::length_error("Bindless storage buffer table is full");
+
+        VkDescriptorBufferInfo buffer_info{};
+        buffer_info.buffer = buffer.get_vk_handle();
+        buffer_info.offset = 0;
+        buffer_info.range = VK_WHOLE_SIZE;
+
+        VkWriteDescriptorSet descriptor_write{};
+        descriptor_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptor_write.dstSet = _vk_handle;
+        descriptor_write.dstBinding = storage_buffers_binding;
+        descriptor_write.dstArrayElement = _storage_buffers_count;
+        descriptor_write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        descriptor_write.descriptorCount = 1;
+        descriptor_write.pBufferInfo = &buffer_info;
+
+        vkUpdateDescriptorSets(_logical_device->get_vk_handle(), 1, &descriptor_write, 0, nullptr);
+
+        return _storage_buffers_count++;
+    }
+} // namespace owl::vulkan::core
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <memory>
+
+#include <glm/vec4.hpp>
+
+#include "buffer.h"
+#include "descriptor_pool.h"
+#include "image_view.h"
+#include "logical_device.h"
+#include "sampler.h"
+#include "vulkan_object.h"
+
+namespace owl::vulkan::core
+{
+    // one entry of the material table shaders read from the first storage buffer, laid out with std430 rules
+    struct bindless_material
+    {
+        uint32_t texture_index = 0;
+        uint32_t padding[3] = {};
+        glm::vec4 tint{1.0f};
+    };
+
+    // pushed before each draw, the shaders find everything else through the material
+    struct bindless_draw_constants
+    {
+        uint32_t material_id;
+    };
+
+    // a single update after bind set holding every texture and storage buffer shaders may read, so a draw selects its resources
+    // by index instead of binding a set; slots are partially bound, and new ones can be written while frames are in flight
+    class bindless_table : public vulkan_object<VkDescriptorSet>
+    {
+    public:
+        static constexpr uint32_t storage_buffers_binding = 0;
+        static constexpr uint32_t sampler_binding = 1;
+        static constexpr uint32_t textures_binding = 2;
+
+        bindless_table(const std::shared_ptr<logical_device>& logical_device,
+                       const sampler& sampler,
+                       uint32_t max_textures,
+                       uint32_t max_storage_buffers);
+        ~bindless_table();
+
+        bindless_table(const bindless_table&) = delete;
+        bindless_table& operator=(const bindless_table&) = delete;
+
+        const VkDescriptorSetLayout& get_vk_descriptor_set_layout() const { return _vk_descriptor_set_layout; }
+        uint32_t get_max_textures() const { return _max_textures; }
+        uint32_t get_textures_count() const { return _textures_count; }
+        uint32_t get_storage_buffers_count() const { return _storage_buffers_count; }
+
+        // slots are only appended: a written slot may be read by frames in flight, so it is never rewritten
+        uint32_t add_texture(const image_view& image_view);
+        uint32_t add_storage_buffer(const buffer& buffer);
+
+    private:
+        std::shared_ptr<logical_device> _logical_device;
+        VkDescriptorSetLayout _vk_descriptor_set_layout = VK_NULL_HANDLE;
+        std::unique_ptr<descriptor_pool> _pool;
+        uint32_t _max_textures;
+        uint32_t _max_storage_buffers;
+        uint32_t _textures_count = 0;
+        uint32_t _storage_buffers_count = 0;
+    };
+} // namespace owl::vulkan::core
\ No newline at end of file
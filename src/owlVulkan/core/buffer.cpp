@@ -1,47 +1,118 @@
 #include "buffer.h"
 
-#include "command_buffers.h"
+#include "upload_context.h"
 
 namespace owl::vulkan::core
 {
-    buffer::buffer(const std::shared_ptr<physical_device>& physical_device,
+    buffer::buffer(const std::shared_ptr<memory_allocator>& memory_allocator,
                    const std::shared_ptr<logical_device>& logical_device,
+                   memory_category category,
                    VkBufferUsageFlags usage,
                    VkSharingMode sharing_mode,
                    VkMemoryPropertyFlags properties,
-                   VkDeviceSize size)
+                   VkDeviceSize size,
+                   VkMemoryPropertyFlags preferred_properties)
         : _logical_device(logical_device)
+        , _memory_allocator(memory_allocator)
         , _size(size)
+        , _usage(usage)
+        , _sharing_mode(sharing_mode)
     {
-        VkBufferCreateInfo buffer_info{};
-        buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        buffer_info.size = size;
-        buffer_info.usage = usage;
-        buffer_info.sharingMode = sharing_mode;
-
-        auto result = vkCreateBuffer(_logical_device->get_vk_handle(), &buffer_info, nullptr, &_vk_handle);
-        helpers::handle_result(result, "Failed to create buffer.");
+        _vk_handle = create_vk_buffer();
 
         VkMemoryRequirements memory_requirements;
         vkGetBufferMemoryRequirements(_logical_device->get_vk_handle(), _vk_handle, &memory_requirements);
 
-        _device_memory = std::make_unique<device_memory>(physical_device, _logical_device, memory_requirements, properties);
-        vkBindBufferMemory(_logical_device->get_vk_handle(), _vk_handle, get_vk_device_memory(), 0);
+        _memory_allocation =
+            _memory_allocator->allocate(memory_requirements, properties, resource_tiling::linear, category, preferred_properties);
+        vkBindBufferMemory(_logical_device->get_vk_handle(), _vk_handle, get_vk_device_memory(), get_memory_offset());
+    }
+
+    buffer::~buffer()
+    {
+        release_retired();
+
+        vkDestroyBuffer(_logical_device->get_vk_handle(), _vk_handle, _logical_device->get_allocation_callbacks(host_object_type::buffer));
+        _memory_allocator->free(_memory_allocation);
+    }
+
+    bool buffer::is_movable() const
+    {
+        // host visible buffers are written directly by the cpu and cannot follow a gpu copy
+        bool is_transferable = (_usage & VK_BUFFER_USAGE_TRANSFER_SRC_BIT) && (_usage & VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+        return is_transferable && get_mapped_data() == nullptr && _retired_vk_handle == VK_NULL_HANDLE;
+    }
+
+    bool buffer::move(const VkCommandBuffer& vk_command_buffer)
+    {
+        VkBuffer new_vk_handle = create_vk_buffer();
+
+        VkMemoryRequirements memory_requirements;
+        vkGetBufferMemoryRequirements(_logical_device->get_vk_handle(), new_vk_handle, &memory_requirements);
+
+        auto new_allocation = _memory_allocator->reallocate(_memory_allocation, memory_requirements);
+        if (!new_allocation.has_value())
+        {
+            vkDestroyBuffer(_logical_device->get_vk_handle(),
+                            new_vk_handle,
+                            _logical_device->get_allocation_callbacks(host_object_type::buffer));
+            return false;
+        }
+
+        vkBindBufferMemory(_logical_device->get_vk_handle(), new_vk_handle, new_allocation->get_vk_device_memory(), new_allocation->offset);
+
+        VkBufferCopy copy_region{};
+        copy_region.size = _size;
+        vkCmdCopyBuffer(vk_command_buffer, _vk_handle, new_vk_handle, 1, &copy_region);
+
+        // the old buffer stays alive until the copy and every recording that still references it are done
+        _retired_vk_handle = _vk_handle;
+        _retired_memory_allocation = _memory_allocation;
+        _vk_handle = new_vk_handle;
+        _memory_allocation = new_allocation.value();
+
+        return true;
     }
 
-    buffer::~buffer() { vkDestroyBuffer(_logical_device->get_vk_handle(), _vk_handle, nullptr); }
+    void buffer::release_retired()
+    {
+        if (_retired_vk_handle == VK_NULL_HANDLE)
+            return;
 
-    void buffer::copy_buffer(const VkBuffer& source_buffer, VkDeviceSize size, const std::shared_ptr<command_pool>& command_pool)
+        vkDestroyBuffer(_logical_device->get_vk_handle(),
+                        _retired_vk_handle,
+                        _logical_device->get_allocation_callbacks(host_object_type::buffer));
+        _memory_allocator->free(_retired_memory_allocation);
+
+        _retired_vk_handle = VK_NULL_HANDLE;
+        _retired_memory_allocation = {};
+    }
+
+    VkBuffer buffer::create_vk_buffer() const
     {
-        command_buffers command_buffers(_logical_device, command_pool, 1);
-        command_buffers.process_command_buffers(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
-                                                [this, size, &source_buffer](const VkCommandBuffer& vk_command_buffer, size_t index) {
-                                                    VkBufferCopy copy_region{};
-                                                    copy_region.size = size;
-                                                    vkCmdCopyBuffer(vk_command_buffer, source_buffer, _vk_handle, 1, &copy_region);
-                                                });
-
-        _logical_device->submit_to_graphics_queue(command_buffers);
+        VkBufferCreateInfo buffer_info{};
+        buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        buffer_info.size = _size;
+        buffer_info.usage = _usage;
+        buffer_info.sharingMode = _sharing_mode;
+
+        VkBuffer vk_buffer;
+        auto result = vkCreateBuffer(_logical_device->get_vk_handle(),
+                                     &buffer_info,
+                                     _logical_device->get_allocation_callbacks(host_object_type::buffer),
+                                     &vk_buffer);
+        helpers::handle_result(result, "Failed to create buffer.");
+
+        return vk_buffer;
+    }
+
+    void buffer::copy_buffer(const VkCommandBuffer& vk_command_buffer, const staging_region& source_region, VkDeviceSize destination_offset)
+    {
+        VkBufferCopy copy_region{};
+        copy_region.srcOffset = source_region.offset;
+        copy_region.dstOffset = destination_offset;
+        copy_region.size = source_region.size;
+        vkCmdCopyBuffer(vk_command_buffer, source_region.buffer, _vk_handle, 1, &copy_region);
     }
 
     void copy_memory(const void* values,
@@ -49,26 +120,37 @@ namespace owl::vulkan::core
                      const buffer& buffer,
                      const VkDeviceSize buffer_size)
     {
-        void* data;
-        vkMapMemory(logical_device->get_vk_handle(), buffer.get_vk_device_memory(), 0, buffer_size, 0, &data);
-        memcpy(data, values, (size_t)buffer_size);
-        vkUnmapMemory(logical_device->get_vk_handle(), buffer.get_vk_device_memory());
+        memcpy(buffer.get_mapped_data(), values, (size_t)buffer_size);
     }
 
-    std::shared_ptr<buffer> create_staging_buffer(const void* values,
-                                                  const std::shared_ptr<physical_device> physical_device,
-                                                  const std::shared_ptr<logical_device> logical_device,
-                                                  const VkDeviceSize buffer_size)
+    std::shared_ptr<buffer> create_device_local_buffer(const void* values,
+                                                       const std::shared_ptr<memory_allocator> memory_allocator,
+                                                       const std::shared_ptr<logical_device> logical_device,
+                                                       upload_context& upload_context,
+                                                       memory_category category,
+                                                       VkBufferUsageFlags usage,
+                                                       const VkDeviceSize buffer_size,
+                                                       bool is_direct_write_allowed)
     {
-        auto staging_buffer = std::make_shared<buffer>(physical_device,
-                                                       logical_device,
-                                                       VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                                                       VK_SHARING_MODE_EXCLUSIVE,
-                                                       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                                                       buffer_size);
+        // on unified memory the device local allocation can usually be written directly, without a staging copy
+        bool is_direct_write = is_direct_write_allowed && memory_allocator->is_unified_memory();
+        VkMemoryPropertyFlags preferred_properties =
+            is_direct_write ? VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT : 0;
+
+        auto buffer = std::make_shared<vulkan::core::buffer>(memory_allocator,
+                                                             logical_device,
+                                                             category,
+                                                             usage,
+                                                             VK_SHARING_MODE_EXCLUSIVE,
+                                                             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                             buffer_size,
+                                                             preferred_properties);
 
-        copy_memory(values, logical_device, *staging_buffer, buffer_size);
+        if (is_direct_write && buffer->get_mapped_data() != nullptr && buffer->is_host_coherent())
+            copy_memory(values, logical_device, *buffer, buffer_size);
+        else
+            upload_context.copy_buffer(*buffer, values, buffer_size);
 
-        return staging_buffer;
+        return buffer;
     }
 } // namespace owl::vulkan
\ No newline at end of file
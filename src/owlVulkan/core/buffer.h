@@ -5,34 +5,56 @@
 #include <memory>
 
 #include "../helpers/vulkan_helpers.h"
-#include "command_pool.h"
 #include "device_memory.h"
 #include "logical_device.h"
-#include "physical_device.h"
+#include "memory_allocator.h"
 #include "vulkan_object.h"
 
 namespace owl::vulkan::core
 {
+    class upload_context;
+    struct staging_region;
+
     class buffer : public vulkan_object<VkBuffer>
     {
     public:
-        buffer(const std::shared_ptr<physical_device>& physical_device,
+        buffer(const std::shared_ptr<memory_allocator>& memory_allocator,
                const std::shared_ptr<logical_device>& logical_device,
+               memory_category category,
                VkBufferUsageFlags usage,
                VkSharingMode sharing_mode,
                VkMemoryPropertyFlags properties,
-               VkDeviceSize size);
+               VkDeviceSize size,
+               VkMemoryPropertyFlags preferred_properties = 0);
         ~buffer();
 
         size_t get_size() const { return _size; }
-        const VkDeviceMemory& get_vk_device_memory() const { return _device_memory->get_vk_handle(); }
+        const VkDeviceMemory& get_vk_device_memory() const { return _memory_allocation.get_vk_device_memory(); }
+        VkDeviceSize get_memory_offset() const { return _memory_allocation.offset; }
+        void* get_mapped_data() const { return _memory_allocation.get_mapped_data(); }
+        bool is_host_coherent() const { return _memory_allocation.get_property_flags() & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT; }
+
+        void copy_buffer(const VkCommandBuffer& vk_command_buffer,
+                         const staging_region& source_region,
+                         VkDeviceSize destination_offset = 0);
 
-        void copy_buffer(const VkBuffer& source_buffer, VkDeviceSize size, const std::shared_ptr<command_pool>& command_pool);
+        bool is_movable() const;
+        const memory_block* get_memory_block() const { return _memory_allocation.block; }
+        bool move(const VkCommandBuffer& vk_command_buffer);
+        void release_retired();
 
     private:
         std::shared_ptr<logical_device> _logical_device;
-        std::unique_ptr<device_memory> _device_memory;
+        std::shared_ptr<memory_allocator> _memory_allocator;
+        memory_allocation _memory_allocation;
         size_t _size;
+        VkBufferUsageFlags _usage;
+        VkSharingMode _sharing_mode;
+
+        VkBuffer _retired_vk_handle = VK_NULL_HANDLE;
+        memory_allocation _retired_memory_allocation;
+
+        VkBuffer create_vk_buffer() const;
     };
 
     void copy_memory(const void* values,
@@ -40,30 +62,24 @@ namespace owl::vulkan::core
                      const buffer& buffer,
                      const VkDeviceSize buffer_size);
 
-    std::shared_ptr<buffer> create_staging_buffer(const void* values,
-                                                  const std::shared_ptr<physical_device> physical_device,
-                                                  const std::shared_ptr<logical_device> logical_device,
-                                                  const VkDeviceSize buffer_size);
+    std::shared_ptr<buffer> create_device_local_buffer(const void* values,
+                                                       const std::shared_ptr<memory_allocator> memory_allocator,
+                                                       const std::shared_ptr<logical_device> logical_device,
+                                                       upload_context& upload_context,
+                                                       memory_category category,
+                                                       VkBufferUsageFlags usage,
+                                                       const VkDeviceSize buffer_size,
+                                                       bool is_direct_write_allowed = true);
 
     template <typename TValue>
     std::shared_ptr<buffer> create_buffer(const std::vector<TValue>& values,
-                                          const std::shared_ptr<physical_device> physical_device,
+                                          const std::shared_ptr<memory_allocator> memory_allocator,
                                           const std::shared_ptr<logical_device> logical_device,
-                                          const std::shared_ptr<command_pool>& command_pool,
+                                          upload_context& upload_context,
+                                          memory_category category,
                                           VkBufferUsageFlags usage)
     {
         VkDeviceSize buffer_size = sizeof(values[0]) * values.size();
-        auto staging_buffer = create_staging_buffer(values.data(), physical_device, logical_device, buffer_size);
-
-        auto buffer = std::make_shared<vulkan::core::buffer>(physical_device,
-                                                             logical_device,
-                                                             usage,
-                                                             VK_SHARING_MODE_EXCLUSIVE,
-                                                             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                                                             buffer_size);
-
-        buffer->copy_buffer(staging_buffer->get_vk_handle(), buffer_size, command_pool);
-
-        return buffer;
+        return create_device_local_buffer(values.data(), memory_allocator, logical_device, upload_context, category, usage, buffer_size);
     }
 } // namespace owl::vulkan::core
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <array>
 
 #include "../helpers/vulkan_helpers.h"
+#include "geometry_pool.h"
 
 namespace owl::vulkan::core
 {
@@ -32,24 +33,23 @@ namespace owl::vulkan::core
                              _vk_command_buffers.data());
     }
 
-    void command_buffers::process_command_buffers(VkCommandBufferUsageFlags begin_flags,
-                                                  const std::function<void(const VkCommandBuffer&, size_t)>& action)
+    void command_buffers::begin(size_t index, VkCommandBufferUsageFlags begin_flags)
     {
-        for (size_t i = 0; i < _vk_command_buffers.size(); ++i)
-        {
-            VkCommandBufferBeginInfo begin_info{};
-            begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-            begin_info.flags = begin_flags;
-            begin_info.pInheritanceInfo = nullptr;
-
-            auto begin_result = vkBeginCommandBuffer(_vk_command_buffers[i], &begin_info);
-            vulkan::helpers::handle_result(begin_result, "Failed to begin recording command buffer" + std::to_string(i));
-
-            action(_vk_command_buffers[i], i); // TODO consider use a functor instead of lambda
+        VkCommandBufferBeginInfo begin_info{};
+        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        begin_info.flags = begin_flags;
+        begin_info.pInheritanceInfo = nullptr;
+
+        auto begin_result = vkBeginCommandBuffer(_vk_command_buffers[index], &begin_info);
+        if (begin_result != VK_SUCCESS)
+            vulkan::helpers::handle_result(begin_result, "Failed to begin recording command buffer" + std::to_string(index));
+    }
 
-            auto end_result = vkEndCommandBuffer(_vk_command_buffers[i]);
-            vulkan::helpers::handle_result(end_result, "Failed to end recording command buffer" + std::to_string(i));
-        }
+    void command_buffers::end(size_t index)
+    {
+        auto end_result = vkEndCommandBuffer(_vk_command_buffers[index]);
+        if (end_result != VK_SUCCESS)
+            vulkan::helpers::handle_result(end_result, "Failed to end recording command buffer" + std::to_string(index));
     }
 
     void process_engine_command_buffer(const VkCommandBuffer& vk_command_buffer,
@@ -57,11 +57,15 @@ namespace owl::vulkan::core
                                        const std::shared_ptr<graphics_pipeline>& graphics_pipeline,
                                        const std::shared_ptr<render_pass>& render_pass,
                                        const std::shared_ptr<swapchain>& swapchain,
-                                       const std::shared_ptr<buffer>& vertex_buffer,
-                                       const std::shared_ptr<buffer>& index_buffer,
+                                       const std::shared_ptr<geometry_pool>& geometry_pool,
+                                       const std::vector<mesh_handle>& meshes,
                                        const std::shared_ptr<descriptor_sets>& descriptor_sets,
-                                       const std::shared_ptr<pipeline_layout>& pipeline_layout,
-                                       const uint32_t indices_size)
+                                       const std::shared_ptr<push_descriptors>& push_descriptors,
+                                       const object_bindings& draw_bindings,
+                                       const std::shared_ptr<bindless_table>& bindless_table,
+                                       const std::vector<uint32_t>& mesh_materials,
+                                       const std::shared_ptr<ring_buffer>& uniform_buffer,
+                                       const std::shared_ptr<pipeline_layout>& pipeline_layout)
     {
         VkRenderPassBeginInfo render_pass_info{};
         render_pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -96,21 +100,55 @@ namespace owl::vulkan::core
         vkCmdSetViewport(vk_command_buffer, 0, 1, &viewport);
         vkCmdSetScissor(vk_command_buffer, 0, 1, &scissor);
 
-        VkBuffer vertex_buffers[] = {vertex_buffer->get_vk_handle()};
+        VkBuffer vertex_buffers[] = {geometry_pool->get_vertex_buffer()->get_vk_handle()};
         VkDeviceSize offsets[] = {0};
 
         vkCmdBindVertexBuffers(vk_command_buffer, 0, 1, vertex_buffers, offsets);
-        vkCmdBindIndexBuffer(vk_command_buffer, index_buffer->get_vk_handle(), 0, VK_INDEX_TYPE_UINT32);
-        vkCmdBindDescriptorSets(vk_command_buffer,
-                                VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                pipeline_layout->get_vk_handle(),
-                                0,
-                                1,
-                                &(descriptor_sets->get_vk_descriptor_sets()[index]),
-                                0,
-                                nullptr);
-
-        vkCmdDrawIndexed(vk_command_buffer, indices_size, 1, 0, 0, 0);
+        vkCmdBindIndexBuffer(vk_command_buffer, geometry_pool->get_index_buffer()->get_vk_handle(), 0, VK_INDEX_TYPE_UINT32);
+
+        auto uniform_offset = static_cast<uint32_t>(uniform_buffer->get_region_offset(static_cast<uint32_t>(index)));
+        if (push_descriptors == nullptr)
+            vkCmdBindDescriptorSets(vk_command_buffer,
+                                    VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                    pipeline_layout->get_vk_handle(),
+                                    0,
+                                    1,
+                                    &(descriptor_sets->get_vk_descriptor_sets()[index]),
+                                    1,
+                                    &uniform_offset);
+
+        // the table is bound once, draws only tell the shaders which material to read
+        if (bindless_table != nullptr)
+            vkCmdBindDescriptorSets(vk_command_buffer,
+                                    VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                    pipeline_layout->get_vk_handle(),
+                                    1,
+                                    1,
+                                    &bindless_table->get_vk_handle(),
+                                    0,
+                                    nullptr);
+
+        // pushed bindings are recorded per draw, a pushed uniform buffer takes its region offset in the buffer info
+        auto bindings = draw_bindings;
+        bindings.uniform_buffer.offset = uniform_offset;
+
+        for (size_t i = 0; i < meshes.size(); ++i)
+        {
+            const auto& range = geometry_pool->get_mesh_range(meshes[i]);
+            if (push_descriptors != nullptr)
+                push_descriptors->push(vk_command_buffer, bindings);
+            if (bindless_table != nullptr)
+            {
+                bindless_draw_constants draw_constants{mesh_materials[i]};
+                vkCmdPushConstants(vk_command_buffer,
+                                   pipeline_layout->get_vk_handle(),
+                                   VK_SHADER_STAGE_FRAGMENT_BIT,
+                                   0,
+                                   sizeof(bindless_draw_constants),
+                                   &draw_constants);
+            }
+            vkCmdDrawIndexed(vk_command_buffer, range.index_count, 1, range.first_index, range.vertex_offset, 0);
+        }
 
         vkCmdEndRenderPass(vk_command_buffer);
     }
@@ -2,22 +2,28 @@
 
 #include <vulkan/vulkan.h>
 
-#include <functional>
 #include <vector>
 
+#include "bindless_table.h"
 #include "buffer.h"
 #include "command_pool.h"
 #include "descriptor_sets.h"
 #include "framebuffer.h"
 #include "graphics_pipeline.h"
 #include "logical_device.h"
+#include "mesh_range.h"
+#include "object_bindings.h"
 #include "pipeline_layout.h"
+#include "push_descriptors.h"
 #include "render_pass.h"
+#include "ring_buffer.h"
 #include "swapchain.h"
 #include "vertex.h"
 
 namespace owl::vulkan::core
 {
+    class geometry_pool;
+
     class command_buffers
     {
     public:
@@ -28,8 +34,11 @@ namespace owl::vulkan::core
 
         const std::vector<VkCommandBuffer>& get_vk_command_buffers() const { return _vk_command_buffers; }
 
-        void process_command_buffers(VkCommandBufferUsageFlags begin_flags,
-                                     const std::function<void(const VkCommandBuffer&, size_t)>& action);
+        void begin(size_t index, VkCommandBufferUsageFlags begin_flags);
+        void end(size_t index);
+
+        template <typename TAction>
+        void process_command_buffers(VkCommandBufferUsageFlags begin_flags, TAction&& action);
 
     private:
         std::vector<VkCommandBuffer> _vk_command_buffers;
@@ -42,10 +51,25 @@ namespace owl::vulkan::core
                                        const std::shared_ptr<graphics_pipeline>& graphics_pipeline,
                                        const std::shared_ptr<render_pass>& render_pass,
                                        const std::shared_ptr<swapchain>& swapchain,
-                                       const std::shared_ptr<buffer>& vertex_buffer,
-                                       const std::shared_ptr<buffer>& index_buffer,
+                                       const std::shared_ptr<geometry_pool>& geometry_pool,
+                                       const std::vector<mesh_handle>& meshes,
                                        const std::shared_ptr<descriptor_sets>& descriptor_sets,
-                                       const std::shared_ptr<pipeline_layout>& pipeline_layout,
-                                       const uint32_t indices_size);
+                                       const std::shared_ptr<push_descriptors>& push_descriptors,
+                                       const object_bindings& draw_bindings,
+                                       const std::shared_ptr<bindless_table>& bindless_table,
+                                       const std::vector<uint32_t>& mesh_materials,
+                                       const std::shared_ptr<ring_buffer>& uniform_buffer,
+                                       const std::shared_ptr<pipeline_layout>& pipeline_layout);
+
+    template <typename TAction>
+    void command_buffers::process_command_buffers(VkCommandBufferUsageFlags begin_flags, TAction&& action)
+    {
+        for (size_t i = 0; i < _vk_command_buffers.size(); ++i)
+        {
+            begin(i, begin_flags);
+            action(_vk_command_buffers[i], i);
+            end(i);
+        }
+    }
 
 } // namespace owl::vulkan
\ No newline at end of file
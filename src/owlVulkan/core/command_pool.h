@@ -13,7 +13,7 @@ namespace owl::vulkan::core
     public:
         command_pool(const std::shared_ptr<logical_device>& logical_device,
                      const std::shared_ptr<surface>& surface,
-                     uint32_t graphics_queue_family_index);
+                     uint32_t queue_family_index);
         ~command_pool();
 
     private:
@@ -6,8 +6,9 @@
 
 namespace owl::vulkan::core
 {
-    debug_messenger::debug_messenger(const VkInstance& vk_instance)
+    debug_messenger::debug_messenger(const VkInstance& vk_instance, const VkAllocationCallbacks* allocation_callbacks)
         : _vk_instance(vk_instance)
+        , _allocation_callbacks(allocation_callbacks)
     {
         VkDebugUtilsMessengerCreateInfoEXT create_info{};
         configure_debug_create_info(create_info);
@@ -16,7 +17,7 @@ namespace owl::vulkan::core
             (PFN_vkCreateDebugUtilsMessengerEXT)vkGetInstanceProcAddr(_vk_instance, "vkCreateDebugUtilsMessengerEXT");
 
         VkResult result = create_debug_utils_messenger != nullptr
-                              ? create_debug_utils_messenger(_vk_instance, &create_info, nullptr, &_vk_handle)
+                              ? create_debug_utils_messenger(_vk_instance, &create_info, _allocation_callbacks, &_vk_handle)
                               : VK_ERROR_EXTENSION_NOT_PRESENT;
 
         vulkan::helpers::handle_result(result, "Failed to setup debug messenger");
@@ -27,7 +28,7 @@ namespace owl::vulkan::core
         auto destroy_debug_utils_messenger =
             (PFN_vkDestroyDebugUtilsMessengerEXT)vkGetInstanceProcAddr(_vk_instance, "vkDestroyDebugUtilsMessengerEXT");
         if (destroy_debug_utils_messenger != nullptr)
-            destroy_debug_utils_messenger(_vk_instance, _vk_handle, nullptr);
+            destroy_debug_utils_messenger(_vk_instance, _vk_handle, _allocation_callbacks);
     }
 
     void debug_messenger::configure_debug_create_info(VkDebugUtilsMessengerCreateInfoEXT& create_info)
@@ -11,7 +11,7 @@ namespace owl::vulkan::core
     class debug_messenger : public vulkan_object<VkDebugUtilsMessengerEXT>
     {
     public:
-        explicit debug_messenger(const VkInstance& vk_instance);
+        debug_messenger(const VkInstance& vk_instance, const VkAllocationCallbacks* allocation_callbacks);
         ~debug_messenger();
 
         static void configure_debug_create_info(VkDebugUtilsMessengerCreateInfoEXT& create_info);
@@ -23,5 +23,6 @@ namespace owl::vulkan::core
 
     private:
         const VkInstance& _vk_instance;
+        const VkAllocationCallbacks* _allocation_callbacks;
     };
 } // namespace owl::vulkan
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include "defragmenter.h"
+
+#include <algorithm>
+
+namespace owl::vulkan::core
+{
+    defragmenter::defragmenter(const std::shared_ptr<memory_allocator>& memory_allocator,
+                               const std::shared_ptr<upload_context>& upload_context,
+                               const std::shared_ptr<deletion_queue>& deletion_queue)
+        : _memory_allocator(memory_allocator)
+        , _upload_context(upload_context)
+        , _deletion_queue(deletion_queue)
+    {
+    }
+
+    void defragmenter::register_buffer(const std::shared_ptr<buffer>& buffer, std::function<void()> on_moved)
+    {
+        _resources.push_back({buffer, {}, std::move(on_moved)});
+    }
+
+    void defragmenter::register_image(const std::shared_ptr<image>& image, std::function<void()> on_moved)
+    {
+        _resources.push_back({{}, image, std::move(on_moved)});
+    }
+
+    size_t defragmenter::step(std::chrono::microseconds time_budget, VkDeviceSize size_budget)
+    {
+        if (!_completed_moves.empty())
+            release_completed_moves();
+
+        if (!_pending_moves.empty())
+        {
+            if (_pending_token.is_complete())
+                complete_pending_moves();
+
+            return 0;
+        }
+
+        _resources.erase(std::remove_if(_resources.begin(),
+                                        _resources.end(),
+                                        [](const resource& resource)
+                                        { return resource.moved_buffer.expired() && resource.moved_image.expired(); }),
+                         _resources.end());
+
+        const memory_block* source_block = _memory_allocator->find_defragmentation_source();
+        if (source_block == nullptr)
+            return 0;
+
+        auto start_time = std::chrono::steady_clock::now();
+        VkDeviceSize moved_size = 0;
+
+        for (const auto& resource : _resources)
+        {
+            if (moved_size >= size_budget || std::chrono::steady_clock::now() - start_time >= time_budget)
+                break;
+
+            if (try_move(resource, source_block, moved_size))
+                _pending_moves.push_back(resource);
+        }
+
+        if (_pending_moves.empty())
+            return 0;
+
+        _pending_token = _upload_context->submit();
+
+        _statistics.moves_count += _pending_moves.size();
+        _statistics.moved_size += moved_size;
+
+        return _pending_moves.size();
+    }
+
+    defragmentation_statistics defragmenter::get_statistics() const
+    {
+        auto statistics = _statistics;
+        statistics.fragmentation = _memory_allocator->get_statistics().fragmentation;
+        return statistics;
+    }
+
+    void defragmenter::complete_pending_moves()
+    {
+        for (const auto& resource : _pending_moves)
+        {
+            if (resource.on_moved)
+                resource.on_moved();
+        }
+
+        _completed_moves = std::move(_pending_moves);
+        _pending_moves.clear();
+    }
+
+    void defragmenter::release_completed_moves()
+    {
+        for (const auto& resource : _completed_moves)
+        {
+            _deletion_queue->enqueue(
+                [moved_buffer = resource.moved_buffer, moved_image = resource.moved_image]()
+                {
+                    if (auto buffer = moved_buffer.lock())
+                        buffer->release_retired();
+                    if (auto image = moved_image.lock())
+                        image->release_retired();
+                });
+        }
+
+        _completed_moves.clear();
+    }
+
+    bool defragmenter::try_move(const resource& resource, const memory_block* source_block, VkDeviceSize& moved_size)
+    {
+        if (auto moved_buffer = resource.moved_buffer.lock())
+        {
+            if (moved_buffer->get_memory_block() != source_block || !moved_buffer->is_movable())
+                return false;
+            if (!moved_buffer->move(_upload_context->get_vk_graphics_command_buffer()))
+                return false;
+
+            moved_size += moved_buffer->get_size();
+            return true;
+        }
+
+        if (auto moved_image = resource.moved_image.lock())
+        {
+            if (moved_image->get_memory_block() != source_block || !moved_image->is_movable())
+                return false;
+            if (!moved_image->move(_upload_context->get_vk_graphics_command_buffer()))
+                return false;
+
+            moved_size += moved_image->get_memory_size();
+            return true;
+        }
+
+        return false;
+    }
+} // namespace owl::vulkan::core
\ No newline at end of file
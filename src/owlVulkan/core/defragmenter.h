@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "buffer.h"
+#include "deletion_queue.h"
+#include "image.h"
+#include "memory_allocator.h"
+#include "upload_context.h"
+
+namespace owl::vulkan::core
+{
+    struct defragmentation_statistics
+    {
+        size_t moves_count = 0;
+        VkDeviceSize moved_size = 0;
+        float fragmentation = 0.0f;
+    };
+
+    // moves live resources out of the emptiest memory block so it can be released; a resource's callback runs once its copy
+    // has completed, and its old handle is retired on the following step, after the owner rebuilt what referenced it, then
+    // destroyed by the deletion queue once the frames that used it are done
+    class defragmenter
+    {
+    public:
+        defragmenter(const std::shared_ptr<memory_allocator>& memory_allocator,
+                     const std::shared_ptr<upload_context>& upload_context,
+                     const std::shared_ptr<deletion_queue>& deletion_queue);
+        ~defragmenter() = default;
+
+        void register_buffer(const std::shared_ptr<buffer>& buffer, std::function<void()> on_moved);
+        void register_image(const std::shared_ptr<image>& image, std::function<void()> on_moved);
+
+        bool is_moving() const { return !_pending_moves.empty() || !_completed_moves.empty(); }
+        size_t step(std::chrono::microseconds time_budget, VkDeviceSize size_budget);
+
+        defragmentation_statistics get_statistics() const;
+
+    private:
+        struct resource
+        {
+            std::weak_ptr<buffer> moved_buffer;
+            std::weak_ptr<image> moved_image;
+            std::function<void()> on_moved;
+        };
+
+        std::shared_ptr<memory_allocator> _memory_allocator;
+        std::shared_ptr<upload_context> _upload_context;
+        std::shared_ptr<deletion_queue> _deletion_queue;
+
+        std::vector<resource> _resources;
+        std::vector<resource> _pending_moves;
+        std::vector<resource> _completed_moves;
+        upload_token _pending_token;
+
+        defragmentation_statistics _statistics;
+
+        void complete_pending_moves();
+        void release_completed_moves();
+        bool try_move(const resource& resource, const memory_block* source_block, VkDeviceSize& moved_size);
+    };
+} // namespace owl::vulkan::core
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include "deletion_queue.h"
+
+namespace owl::vulkan::core
+{
+    deletion_queue::~deletion_queue() { flush(); }
+
+    void deletion_queue::enqueue(std::function<void()> deleter) { _entries.push_back({_submitted_value, std::move(deleter)}); }
+
+    void deletion_queue::collect(uint64_t completed_value)
+    {
+        _completed_value = completed_value;
+
+        // entries are enqueued in submission order, so the retired ones are always at the front
+        while (!_entries.empty() && _entries.front().retire_value <= completed_value)
+        {
+            auto deleter = std::move(_entries.front().deleter);
+            _entries.pop_front();
+            deleter();
+        }
+    }
+
+    void deletion_queue::flush()
+    {
+        while (!_entries.empty())
+        {
+            auto deleter = std::move(_entries.front().deleter);
+            _entries.pop_front();
+            deleter();
+        }
+    }
+} // namespace owl::vulkan::core
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+
+namespace owl::vulkan::core
+{
+    // defers the destruction of resources until the gpu has retired every submission that may still use them; submissions are
+    // identified by a monotonically increasing value (a frame number or a timeline semaphore value)
+    class deletion_queue
+    {
+    public:
+        deletion_queue() = default;
+        ~deletion_queue();
+
+        deletion_queue(const deletion_queue&) = delete;
+        deletion_queue& operator=(const deletion_queue&) = delete;
+
+        uint64_t get_submitted_value() const { return _submitted_value; }
+        uint64_t get_completed_value() const { return _completed_value; }
+        size_t get_size() const { return _entries.size(); }
+
+        void set_submitted_value(uint64_t value) { _submitted_value = value; }
+
+        void enqueue(std::function<void()> deleter);
+        template <typename TResource>
+        void retire(std::shared_ptr<TResource>& resource);
+
+        void collect(uint64_t completed_value);
+        void flush();
+
+    private:
+        struct entry
+        {
+            uint64_t retire_value;
+            std::function<void()> deleter;
+        };
+
+        std::deque<entry> _entries;
+        uint64_t _submitted_value = 0;
+        uint64_t _completed_value = 0;
+    };
+
+    template <typename TResource>
+    void deletion_queue::retire(std::shared_ptr<TResource>& resource)
+    {
+        if (resource == nullptr)
+            return;
+
+        // the queue takes over the owner's reference, other holders keep the resource alive as usual
+        enqueue([retired_resource = std::move(resource)]() {});
+    }
+} // namespace owl::vulkan::core
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "descriptor_allocator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../helpers/vulkan_helpers.h"
+
+namespace owl::vulkan::core
+{
+    descriptor_allocator::descriptor_allocator(const std::shared_ptr<logical_device>& logical_device,
+                                               const std::vector<descriptor_pool_ratio>& ratios,
+                                               VkDescriptorPoolCreateFlags pool_flags,
+                                               uint32_t initial_sets_per_pool)
+        : _logical_device(logical_device)
+        , _ratios(ratios)
+        , _pool_flags(pool_flags)
+        , _sets_per_pool(std::clamp(initial_sets_per_pool, 1u, max_sets_per_pool))
+    {
+    }
+
+    size_t descriptor_allocator::get_pools_count() const
+    {
+        return _full_pools.size() + _ready_pools.size() + (_current_pool != nullptr ? 1 : 0);
+    }
+
+    descriptor_allocation descriptor_allocator::allocate(const descriptor_set_layout& layout)
+    {
+        if (_current_pool == nullptr)
+            _current_pool = acquire_pool();
+
+        VkDescriptorSet vk_descriptor_set = VK_NULL_HANDLE;
+        auto result = _current_pool->try_allocate(layout, vk_descriptor_set);
+        if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL)
+        {
+            _full_pools.push_back(std::move(_current_pool));
+            if (try_reuse_full_pool(layout, vk_descriptor_set))
+                result = VK_SUCCESS;
+            else
+            {
+                _current_pool = acquire_pool();
+                result = _current_pool->try_allocate(layout, vk_descriptor_set);
+            }
+        }
+        helpers::handle_result(result, "Failed to allocate descriptor set.");
+
+        _allocated_sets_count++;
+
+        return {vk_descriptor_set, _current_pool};
+    }
+
+    void descriptor_allocator::reset()
+    {
+        if (_current_pool != nullptr)
+            _full_pools.push_back(std::move(_current_pool));
+
+        for (auto& pool : _full_pools)
+        {
+            pool->reset();
+            _ready_pools.push_back(std::move(pool));
+        }
+
+        _full_pools.clear();
+        _allocated_sets_count = 0;
+    }
+
+    bool descriptor_allocator::try_reuse_full_pool(const descriptor_set_layout& layout, VkDescriptorSet& vk_descriptor_set)
+    {
+        // the last full pool is the one that just ran out, it is skipped
+        if (!(_pool_flags & VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT) || _full_pools.size() < 2)
+            return false;
+
+        for (auto pool = _full_pools.begin(); pool != _full_pools.end() - 1; ++pool)
+        {
+            if ((*pool)->get_allocated_sets_count() == (*pool)->get_max_sets())
+                continue;
+
+            auto result = (*pool)->try_allocate(layout, vk_descriptor_set);
+            if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL)
+                continue;
+            helpers::handle_result(result, "Failed to allocate descriptor set.");
+
+            _current_pool = std::move(*pool);
+            _full_pools.erase(pool);
+            return true;
+        }
+
+        return false;
+    }
+
+    std::shared_ptr<descriptor_pool> descriptor_allocator::acquire_pool()
+    {
+        if (!_ready_pools.empty())
+        {
+            auto pool = std::move(_ready_pools.back());
+            _ready_pools.pop_back();
+            return pool;
+        }
+
+        std::vector<VkDescriptorPoolSize> pool_sizes;
+        pool_sizes.reserve(_ratios.size());
+        for (const auto& ratio : _ratios)
+        {
+            auto descriptors_count = static_cast<uint32_t>(std::ceil(ratio.descriptors_per_set * _sets_per_pool));
+            pool_sizes.push_back({ratio.type, std::max(descriptors_count, 1u)});
+        }
+
+        auto pool = std::make_shared<descriptor_pool>(_logical_device, _sets_per_pool, pool_sizes, _pool_flags);
+        _sets_per_pool = std::min(_sets_per_pool * 2, max_sets_per_pool);
+
+        return pool;
+    }
+} // namespace owl::vulkan::core
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "descriptor_pool.h"
+#include "descriptor_set_layout.h"
+#include "logical_device.h"
+
+namespace owl::vulkan::core
+{
+    struct descriptor_pool_ratio
+    {
+        VkDescriptorType type;
+        float descriptors_per_set;
+    };
+
+    struct descriptor_allocation
+    {
+        VkDescriptorSet vk_descriptor_set = VK_NULL_HANDLE;
+        std::shared_ptr<descriptor_pool> pool;
+    };
+
+    // hands out descriptor sets from a chain of pools: a full pool is kept and a twice larger one is chained after it, so
+    // allocating never requires recreating the pools; pools are sized from per set ratios since the layouts are not known up front;
+    // with freeable pools, full pools that had sets freed are tried again before a new pool is chained
+    class descriptor_allocator
+    {
+    public:
+        static constexpr uint32_t default_sets_per_pool = 32;
+        static constexpr uint32_t max_sets_per_pool = 4096;
+
+        descriptor_allocator(const std::shared_ptr<logical_device>& logical_device,
+                             const std::vector<descriptor_pool_ratio>& ratios,
+                             VkDescriptorPoolCreateFlags pool_flags = 0,
+                             uint32_t initial_sets_per_pool = default_sets_per_pool);
+
+        descriptor_allocator(const descriptor_allocator&) = delete;
+        descriptor_allocator& operator=(const descriptor_allocator&) = delete;
+
+        size_t get_pools_count() const;
+        uint64_t get_allocated_sets_count() const { return _allocated_sets_count; }
+
+        descriptor_allocation allocate(const descriptor_set_layout& layout);
+        // every set allocated since the last reset goes back to the pools at once, none of them may still be in use
+        void reset();
+
+    private:
+        std::shared_ptr<logical_device> _logical_device;
+        std::vector<descriptor_pool_ratio> _ratios;
+        VkDescriptorPoolCreateFlags _pool_flags;
+        uint32_t _sets_per_pool;
+
+        std::shared_ptr<descriptor_pool> _current_pool;
+        std::vector<std::shared_ptr<descriptor_pool>> _full_pools;
+        std::vector<std::shared_ptr<descriptor_pool>> _ready_pools;
+        uint64_t _allocated_sets_count = 0;
+
+        bool try_reuse_full_pool(const descriptor_set_layout& layout, VkDescriptorSet& vk_descriptor_set);
+        std::shared_ptr<descriptor_pool> acquire_pool();
+    };
+} // namespace owl::vulkan::core
\ No newline at end of file
@@ -1,33 +1,71 @@
 #include "descriptor_pool.h"
 
-#include <array>
-
 #include "../helpers/vulkan_helpers.h"
 
 namespace owl::vulkan::core
 {
-    descriptor_pool::descriptor_pool(const std::shared_ptr<logical_device>& logical_device, const uint32_t sets_count)
+    descriptor_pool::descriptor_pool(const std::shared_ptr<logical_device>& logical_device,
+                                     const uint32_t max_sets,
+                                     const std::vector<VkDescriptorPoolSize>& pool_sizes,
+                                     VkDescriptorPoolCreateFlags flags)
         : _logical_device(logical_device)
+        , _max_sets(max_sets)
+        , _flags(flags)
     {
-        VkDescriptorPoolSize uniform_pool_size{};
-        uniform_pool_size.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        uniform_pool_size.descriptorCount = sets_count;
-
-        VkDescriptorPoolSize sampler_pool_size{};
-        sampler_pool_size.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        sampler_pool_size.descriptorCount = sets_count;
-
-        std::array<VkDescriptorPoolSize, 2> pool_sizes = {uniform_pool_size, sampler_pool_size};
-
         VkDescriptorPoolCreateInfo pool_info{};
         pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        pool_info.flags = flags;
         pool_info.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
         pool_info.pPoolSizes = pool_sizes.data();
-        pool_info.maxSets = sets_count;
+        pool_info.maxSets = max_sets;
 
-        auto result = vkCreateDescriptorPool(_logical_device->get_vk_handle(), &pool_info, nullptr, &_vk_handle);
+        auto result = vkCreateDescriptorPool(_logical_device->get_vk_handle(),
+                                             &pool_info,
+                                             _logical_device->get_allocation_callbacks(host_object_type::descriptor_pool),
+                                             &_vk_handle);
         helpers::handle_result(result, "Failed to create descriptor pool.");
     }
 
-    descriptor_pool::~descriptor_pool() { vkDestroyDescriptorPool(_logical_device->get_vk_handle(), _vk_handle, nullptr); }
+    descriptor_pool::~descriptor_pool()
+    {
+        vkDestroyDescriptorPool(_logical_device->get_vk_handle(),
+                                _vk_handle,
+                                _logical_device->get_allocation_callbacks(host_object_type::descriptor_pool));
+    }
+
+    VkResult descriptor_pool::try_allocate(const descriptor_set_layout& layout, VkDescriptorSet& vk_descriptor_set)
+    {
+        return try_allocate(layout.get_vk_handle(), vk_descriptor_set);
+    }
+
+    VkResult descriptor_pool::try_allocate(const VkDescriptorSetLayout& vk_layout, VkDescriptorSet& vk_descriptor_set)
+    {
+        VkDescriptorSetAllocateInfo allocate_info{};
+        allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocate_info.descriptorPool = _vk_handle;
+        allocate_info.descriptorSetCount = 1;
+        allocate_info.pSetLayouts = &vk_layout;
+
+        auto result = vkAllocateDescriptorSets(_logical_device->get_vk_handle(), &allocate_info, &vk_descriptor_set);
+        if (result == VK_SUCCESS)
+            _allocated_sets_count++;
+
+        return result;
+    }
+
+    void descriptor_pool::free(const VkDescriptorSet& vk_descriptor_set)
+    {
+        auto result = vkFreeDescriptorSets(_logical_device->get_vk_handle(), _vk_handle, 1, &vk_descriptor_set);
+        helpers::handle_result(result, "Failed to free descriptor set.");
+
+        _allocated_sets_count--;
+    }
+
+    void descriptor_pool::reset()
+    {
+        auto result = vkResetDescriptorPool(_logical_device->get_vk_handle(), _vk_handle, 0);
+        helpers::handle_result(result, "Failed to reset descriptor pool.");
+
+        _allocated_sets_count = 0;
+    }
 } // namespace owl::vulkan
\ No newline at end of file
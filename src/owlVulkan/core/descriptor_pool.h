@@ -3,7 +3,9 @@
 #include <vulkan/vulkan.h>
 
 #include <memory>
+#include <vector>
 
+#include "descriptor_set_layout.h"
 #include "logical_device.h"
 #include "vulkan_object.h"
 
@@ -12,10 +14,26 @@ namespace owl::vulkan::core
     class descriptor_pool : public vulkan_object<VkDescriptorPool>
     {
     public:
-        descriptor_pool(const std::shared_ptr<logical_device>& logical_device, const uint32_t sets_count);
+        descriptor_pool(const std::shared_ptr<logical_device>& logical_device,
+                        const uint32_t max_sets,
+                        const std::vector<VkDescriptorPoolSize>& pool_sizes,
+                        VkDescriptorPoolCreateFlags flags = 0);
         ~descriptor_pool();
 
+        uint32_t get_max_sets() const { return _max_sets; }
+        bool is_freeable() const { return (_flags & VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT) != 0; }
+        uint32_t get_allocated_sets_count() const { return _allocated_sets_count; }
+
+        // returns the allocation result instead of throwing so a full pool can be replaced by the caller
+        VkResult try_allocate(const descriptor_set_layout& layout, VkDescriptorSet& vk_descriptor_set);
+        VkResult try_allocate(const VkDescriptorSetLayout& vk_layout, VkDescriptorSet& vk_descriptor_set);
+        void free(const VkDescriptorSet& vk_descriptor_set);
+        void reset();
+
     private:
         std::shared_ptr<logical_device> _logical_device;
+        uint32_t _max_sets;
+        VkDescriptorPoolCreateFlags _flags;
+        uint32_t _allocated_sets_count = 0;
     };
 } // namespace owl::vulkan
\ No newline at end of file
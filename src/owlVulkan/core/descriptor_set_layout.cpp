@@ -1,18 +1,19 @@
 #include "descriptor_set_layout.h"
 
-#include <array>
+#include <cstddef>
 
 #include "vulkan_helpers.h"
 
 namespace owl::vulkan::core
 {
-    descriptor_set_layout::descriptor_set_layout(const std::shared_ptr<logical_device>& logical_device)
+    descriptor_set_layout::descriptor_set_layout(const std::shared_ptr<logical_device>& logical_device, bool is_push_descriptor)
         : _logical_device(logical_device)
+        , _is_push_descriptor(is_push_descriptor)
     {
         VkDescriptorSetLayoutBinding uniform_layout_binding{};
         uniform_layout_binding.binding = 0;
         uniform_layout_binding.descriptorCount = 1;
-        uniform_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        uniform_layout_binding.descriptorType = get_uniform_descriptor_type();
         uniform_layout_binding.pImmutableSamplers = nullptr;
         uniform_layout_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
 
@@ -23,16 +24,81 @@ namespace owl::vulkan::core
         sampler_layout_binding.pImmutableSamplers = nullptr;
         sampler_layout_binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
 
-        std::array<VkDescriptorSetLayoutBinding, 2> bindings = {uniform_layout_binding, sampler_layout_binding};
+        std::array<VkDescriptorSetLayoutBinding, bindings_count> bindings = {uniform_layout_binding, sampler_layout_binding};
 
         VkDescriptorSetLayoutCreateInfo layout_info{};
         layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layout_info.flags = is_push_descriptor ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR : 0;
         layout_info.bindingCount = static_cast<uint32_t>(bindings.size());
         layout_info.pBindings = bindings.data();
 
-        auto result = vkCreateDescriptorSetLayout(_logical_device->get_vk_handle(), &layout_info, nullptr, &_vk_handle);
+        auto result = vkCreateDescriptorSetLayout(_logical_device->get_vk_handle(),
+                                                  &layout_info,
+                                                  _logical_device->get_allocation_callbacks(host_object_type::descriptor_set_layout),
+                                                  &_vk_handle);
         helpers::handle_result(result, "Failed to create descriptor set layout");
     }
 
-    descriptor_set_layout::~descriptor_set_layout() { vkDestroyDescriptorSetLayout(_logical_device->get_vk_handle(), _vk_handle, nullptr); }
+    descriptor_set_layout::~descriptor_set_layout()
+    {
+        vkDestroyDescriptorSetLayout(_logical_device->get_vk_handle(),
+                                     _vk_handle,
+                                     _logical_device->get_allocation_callbacks(host_object_type::descriptor_set_layout));
+    }
+
+    VkDescriptorType descriptor_set_layout::get_uniform_descriptor_type() const
+    {
+        // pushed sets carry the uniform offset in the buffer info instead of a dynamic offset
+        return _is_push_descriptor ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    }
+
+    std::array<VkWriteDescriptorSet, descriptor_set_layout::bindings_count> descriptor_set_layout::create_writes(
+        VkDescriptorSet vk_descriptor_set,
+        const object_bindings& bindings) const
+    {
+        VkWriteDescriptorSet buffer_descriptor_write{};
+        buffer_descriptor_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        buffer_descriptor_write.dstSet = vk_descriptor_set;
+        buffer_descriptor_write.dstBinding = 0;
+        buffer_descriptor_write.dstArrayElement = 0;
+        buffer_descriptor_write.descriptorType = get_uniform_descriptor_type();
+        buffer_descriptor_write.descriptorCount = 1;
+        buffer_descriptor_write.pBufferInfo = &bindings.uniform_buffer;
+        buffer_descriptor_write.pImageInfo = nullptr;
+        buffer_descriptor_write.pTexelBufferView = nullptr;
+
+        VkWriteDescriptorSet image_descriptor_write{};
+        image_descriptor_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        image_descriptor_write.dstSet = vk_descriptor_set;
+        image_descriptor_write.dstBinding = 1;
+        image_descriptor_write.dstArrayElement = 0;
+        image_descriptor_write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        image_descriptor_write.descriptorCount = 1;
+        image_descriptor_write.pBufferInfo = nullptr;
+        image_descriptor_write.pImageInfo = &bindings.texture;
+        image_descriptor_write.pTexelBufferView = nullptr;
+
+        return {buffer_descriptor_write, image_descriptor_write};
+    }
+
+    std::vector<VkDescriptorUpdateTemplateEntry> descriptor_set_layout::create_template_entries() const
+    {
+        VkDescriptorUpdateTemplateEntry uniform_entry{};
+        uniform_entry.dstBinding = 0;
+        uniform_entry.dstArrayElement = 0;
+        uniform_entry.descriptorCount = 1;
+        uniform_entry.descriptorType = get_uniform_descriptor_type();
+        uniform_entry.offset = offsetof(object_bindings, uniform_buffer);
+        uniform_entry.stride = sizeof(object_bindings);
+
+        VkDescriptorUpdateTemplateEntry texture_entry{};
+        texture_entry.dstBinding = 1;
+        texture_entry.dstArrayElement = 0;
+        texture_entry.descriptorCount = 1;
+        texture_entry.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        texture_entry.offset = offsetof(object_bindings, texture);
+        texture_entry.stride = sizeof(object_bindings);
+
+        return {uniform_entry, texture_entry};
+    }
 } // namespace owl::vulkan
\ No newline at end of file
@@ -2,7 +2,11 @@
 
 #include <vulkan/vulkan.h>
 
+#include <array>
+#include <vector>
+
 #include "logical_device.h"
+#include "object_bindings.h"
 #include "vulkan_object.h"
 
 namespace owl::vulkan::core
@@ -10,10 +14,21 @@ namespace owl::vulkan::core
     class descriptor_set_layout : public vulkan_object<VkDescriptorSetLayout>
     {
     public:
-        descriptor_set_layout(const std::shared_ptr<logical_device>& logical_device);
+        static constexpr uint32_t bindings_count = 2;
+
+        // push descriptor layouts are never allocated from pools, and cannot hold dynamic uniform buffers
+        descriptor_set_layout(const std::shared_ptr<logical_device>& logical_device, bool is_push_descriptor = false);
         ~descriptor_set_layout();
 
+        bool is_push_descriptor() const { return _is_push_descriptor; }
+        VkDescriptorType get_uniform_descriptor_type() const;
+
+        std::array<VkWriteDescriptorSet, bindings_count> create_writes(VkDescriptorSet vk_descriptor_set,
+                                                                       const object_bindings& bindings) const;
+        std::vector<VkDescriptorUpdateTemplateEntry> create_template_entries() const;
+
     private:
         std::shared_ptr<logical_device> _logical_device;
+        bool _is_push_descriptor;
     };
 } // namespace owl::vulkan
\ No newline at end of file
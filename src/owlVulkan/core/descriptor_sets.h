@@ -3,14 +3,14 @@
 #include <vulkan/vulkan.h>
 
 #include <memory>
+#include <memory_resource>
 #include <vector>
 
-#include "buffer.h"
-#include "descriptor_pool.h"
+#include "descriptor_allocator.h"
 #include "descriptor_set_layout.h"
-#include "image_view.h"
+#include "descriptor_update_template.h"
 #include "logical_device.h"
-#include "sampler.h"
+#include "object_bindings.h"
 
 namespace owl::vulkan::core
 {
@@ -19,16 +19,17 @@ namespace owl::vulkan::core
     public:
         descriptor_sets(const std::shared_ptr<logical_device>& logical_device,
                         const std::shared_ptr<descriptor_set_layout>& layout,
-                        const std::shared_ptr<descriptor_pool>& descriptor_pool,
-                        const std::vector<std::shared_ptr<buffer>>& uniform_buffers,
-                        const std::shared_ptr<image_view>& image_view,
-                        const std::shared_ptr<sampler>& sampler,
-                        const uint32_t sets_count);
+                        const std::shared_ptr<descriptor_update_template>& update_template,
+                        descriptor_allocator& descriptor_allocator,
+                        const object_bindings& bindings,
+                        const uint32_t sets_count,
+                        std::pmr::memory_resource* scratch_resource = std::pmr::get_default_resource());
         ~descriptor_sets();
 
         const std::vector<VkDescriptorSet>& get_vk_descriptor_sets() const { return _vk_descriptor_sets; }
 
     private:
         std::vector<VkDescriptorSet> _vk_descriptor_sets;
+        std::vector<descriptor_allocation> _allocations;
     };
 }
\ No newline at end of file
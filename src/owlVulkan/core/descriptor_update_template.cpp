@@ -0,0 +1,73 @@
+#include "descriptor_update_template.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "../helpers/vulkan_helpers.h"
+
+namespace owl::vulkan::core
+{
+    descriptor_update_template::descriptor_update_template(const std::shared_ptr<logical_device>& logical_device,
+                                                           const descriptor_set_layout& layout,
+                                                           VkPipelineLayout vk_pipeline_layout)
+        : _logical_device(logical_device)
+        , _vk_pipeline_layout(vk_pipeline_layout)
+    {
+        // templates are core since vulkan 1.1, older devices expose the same entry points through the khr extension
+        _create_template = (PFN_vkCreateDescriptorUpdateTemplateKHR)get_device_function("vkCreateDescriptorUpdateTemplate",
+                                                                                        "vkCreateDescriptorUpdateTemplateKHR");
+        _destroy_template = (PFN_vkDestroyDescriptorUpdateTemplateKHR)get_device_function("vkDestroyDescriptorUpdateTemplate",
+                                                                                          "vkDestroyDescriptorUpdateTemplateKHR");
+        _update_with_template = (PFN_vkUpdateDescriptorSetWithTemplateKHR)get_device_function("vkUpdateDescriptorSetWithTemplate",
+                                                                                              "vkUpdateDescriptorSetWithTemplateKHR");
+        if (layout.is_push_descriptor())
+            _push_with_template = (PFN_vkCmdPushDescriptorSetWithTemplateKHR)vkGetDeviceProcAddr(
+                _logical_device->get_vk_handle(), "vkCmdPushDescriptorSetWithTemplateKHR");
+
+        if (_create_template == nullptr || _destroy_template == nullptr || _update_with_template == nullptr ||
+            (layout.is_push_descriptor() && _push_with_template == nullptr))
+            throw std::runtime_error("Descriptor update templates are not supported by the device");
+
+        auto entries = layout.create_template_entries();
+
+        VkDescriptorUpdateTemplateCreateInfo create_info{};
+        create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+        create_info.descriptorUpdateEntryCount = static_cast<uint32_t>(entries.size());
+        create_info.pDescriptorUpdateEntries = entries.data();
+        create_info.templateType = layout.is_push_descriptor() ? VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR
+                                                               : VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+        create_info.descriptorSetLayout = layout.get_vk_handle();
+        create_info.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        create_info.pipelineLayout = vk_pipeline_layout;
+        create_info.set = 0;
+
+        auto result = _create_template(_logical_device->get_vk_handle(),
+                                       &create_info,
+                                       _logical_device->get_allocation_callbacks(host_object_type::descriptor_update_template),
+                                       &_vk_handle);
+        vulkan::helpers::handle_result(result, "Failed to create descriptor update template");
+    }
+
+    descriptor_update_template::~descriptor_update_template()
+    {
+        _destroy_template(_logical_device->get_vk_handle(),
+                          _vk_handle,
+                          _logical_device->get_allocation_callbacks(host_object_type::descriptor_update_template));
+    }
+
+    void descriptor_update_template::update(VkDescriptorSet vk_descriptor_set, const object_bindings& bindings) const
+    {
+        _update_with_template(_logical_device->get_vk_handle(), vk_descriptor_set, _vk_handle, &bindings);
+    }
+
+    void descriptor_update_template::push(VkCommandBuffer vk_command_buffer, const object_bindings& bindings) const
+    {
+        _push_with_template(vk_command_buffer, _vk_handle, _vk_pipeline_layout, 0, &bindings);
+    }
+
+    PFN_vkVoidFunction descriptor_update_template::get_device_function(const char* name, const char* extension_name) const
+    {
+        auto function = vkGetDeviceProcAddr(_logical_device->get_vk_handle(), name);
+        return function != nullptr ? function : vkGetDeviceProcAddr(_logical_device->get_vk_handle(), extension_name);
+    }
+} // namespace owl::vulkan::core
\ No newline at end of file
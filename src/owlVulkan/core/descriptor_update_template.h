@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <memory>
+
+#include "descriptor_set_layout.h"
+#include "logical_device.h"
+#include "object_bindings.h"
+#include "vulkan_object.h"
+
+namespace owl::vulkan::core
+{
+    // writes every binding of a set from one packed object_bindings in a single call, instead of one write struct per binding;
+    // a template made for a push descriptor layout pushes into a command buffer instead of updating a set
+    class descriptor_update_template : public vulkan_object<VkDescriptorUpdateTemplate>
+    {
+    public:
+        descriptor_update_template(const std::shared_ptr<logical_device>& logical_device,
+                                   const descriptor_set_layout& layout,
+                                   VkPipelineLayout vk_pipeline_layout = VK_NULL_HANDLE);
+        ~descriptor_update_template();
+
+        descriptor_update_template(const descriptor_update_template&) = delete;
+        descriptor_update_template& operator=(const descriptor_update_template&) = delete;
+
+        void update(VkDescriptorSet vk_descriptor_set, const object_bindings& bindings) const;
+        void push(VkCommandBuffer vk_command_buffer, const object_bindings& bindings) const;
+
+    private:
+        std::shared_ptr<logical_device> _logical_device;
+        VkPipelineLayout _vk_pipeline_layout;
+        PFN_vkCreateDescriptorUpdateTemplateKHR _create_template = nullptr;
+        PFN_vkDestroyDescriptorUpdateTemplateKHR _destroy_template = nullptr;
+        PFN_vkUpdateDescriptorSetWithTemplateKHR _update_with_template = nullptr;
+        PFN_vkCmdPushDescriptorSetWithTemplateKHR _push_with_template = nullptr;
+
+        PFN_vkVoidFunction get_device_function(const char* name, const char* extension_name) const;
+    };
+} // namespace owl::vulkan::core
\ No newline at end of file
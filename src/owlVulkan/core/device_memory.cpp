@@ -1,41 +1,71 @@
 #include "device_memory.h"
 
+#include <optional>
+
 #include "../helpers/vulkan_helpers.h"
 
 namespace owl::vulkan::core
 {
-    device_memory::device_memory(const std::shared_ptr<physical_device>& physical_device,
-                                 const std::shared_ptr<logical_device>& logical_device,
-                                 const VkMemoryRequirements& memory_requirements,
-                                 VkMemoryPropertyFlags properties)
+    device_memory::device_memory(const std::shared_ptr<logical_device>& logical_device, uint32_t memory_type_index, VkDeviceSize size)
         : _logical_device(logical_device)
+        , _memory_type_index(memory_type_index)
+        , _size(size)
     {
         VkMemoryAllocateInfo memory_allocate_info{};
         memory_allocate_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        memory_allocate_info.allocationSize = memory_requirements.size;
-        memory_allocate_info.memoryTypeIndex = find_memory_type(physical_device, memory_requirements.memoryTypeBits, properties);
+        memory_allocate_info.allocationSize = size;
+        memory_allocate_info.memoryTypeIndex = memory_type_index;
 
-        auto allocate_result = vkAllocateMemory(_logical_device->get_vk_handle(), &memory_allocate_info, nullptr, &_vk_handle);
+        auto allocate_result = vkAllocateMemory(_logical_device->get_vk_handle(),
+                                                &memory_allocate_info,
+                                                _logical_device->get_allocation_callbacks(host_object_type::device_memory),
+                                                &_vk_handle);
         helpers::handle_result(allocate_result, "Failed to allocated buffer memory.");
     }
 
-    device_memory::~device_memory() { vkFreeMemory(_logical_device->get_vk_handle(), _vk_handle, nullptr); }
+    device_memory::~device_memory()
+    {
+        vkFreeMemory(_logical_device->get_vk_handle(),
+                     _vk_handle,
+                     _logical_device->get_allocation_callbacks(host_object_type::device_memory));
+    }
+
+    void* device_memory::map()
+    {
+        void* data;
+        auto result = vkMapMemory(_logical_device->get_vk_handle(), _vk_handle, 0, _size, 0, &data);
+        helpers::handle_result(result, "Failed to map device memory.");
+
+        return data;
+    }
+
+    void device_memory::unmap() { vkUnmapMemory(_logical_device->get_vk_handle(), _vk_handle); }
 
     uint32_t device_memory::find_memory_type(const std::shared_ptr<physical_device>& physical_device,
                                              uint32_t type_filter,
-                                             VkMemoryPropertyFlags properties)
+                                             VkMemoryPropertyFlags properties,
+                                             VkMemoryPropertyFlags preferred_properties)
     {
         VkPhysicalDeviceMemoryProperties memory_properties;
         vkGetPhysicalDeviceMemoryProperties(physical_device->get_vk_handle(), &memory_properties);
 
+        std::optional<uint32_t> memory_type_index;
         for (uint32_t i = 0; i < memory_properties.memoryTypeCount; ++i)
         {
-            if ((type_filter & (1 << i)) && (memory_properties.memoryTypes[i].propertyFlags & properties) == properties)
-            {
+            auto property_flags = memory_properties.memoryTypes[i].propertyFlags;
+            if (!(type_filter & (1 << i)) || (property_flags & properties) != properties)
+                continue;
+
+            if ((property_flags & preferred_properties) == preferred_properties)
                 return i;
-            }
+
+            if (!memory_type_index.has_value())
+                memory_type_index = i;
         }
 
-        throw std::runtime_error("Failed to find suitable memory type.");
+        if (!memory_type_index.has_value())
+            throw std::runtime_error("Failed to find suitable memory type.");
+
+        return memory_type_index.value();
     }
 } // namespace owl::vulkan
\ No newline at end of file
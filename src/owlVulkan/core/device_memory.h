@@ -11,17 +11,23 @@ namespace owl::vulkan::core
     class device_memory : public vulkan_object<VkDeviceMemory>
     {
     public:
-        device_memory(const std::shared_ptr<physical_device>& physical_device,
-                      const std::shared_ptr<logical_device>& logical_device,
-                      const VkMemoryRequirements& memory_requirements,
-                      VkMemoryPropertyFlags properties);
+        device_memory(const std::shared_ptr<logical_device>& logical_device, uint32_t memory_type_index, VkDeviceSize size);
         ~device_memory();
 
+        VkDeviceSize get_size() const { return _size; }
+        uint32_t get_memory_type_index() const { return _memory_type_index; }
+
+        void* map();
+        void unmap();
+
+        static uint32_t find_memory_type(const std::shared_ptr<physical_device>& physical_device,
+                                         uint32_t type_filter,
+                                         VkMemoryPropertyFlags properties,
+                                         VkMemoryPropertyFlags preferred_properties = 0);
+
     private:
         std::shared_ptr<logical_device> _logical_device;
-
-        uint32_t find_memory_type(const std::shared_ptr<physical_device>& physical_device,
-                                  uint32_t type_filter,
-                                  VkMemoryPropertyFlags properties);
+        uint32_t _memory_type_index;
+        VkDeviceSize _size;
     };
 } // namespace owl::vulkan
\ No newline at end of file
@@ -11,11 +11,21 @@ namespace owl::vulkan::core
         fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
         fence_info.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
-        auto fence_result = vkCreateFence(_logical_device->get_vk_handle(), &fence_info, nullptr, &_vk_handle);
+        auto fence_result = vkCreateFence(_logical_device->get_vk_handle(),
+                                          &fence_info,
+                                          _logical_device->get_allocation_callbacks(host_object_type::fence),
+                                          &_vk_handle);
         vulkan::helpers::handle_result(fence_result, "Failed to create fence");
     }
 
-    fence::~fence() { vkDestroyFence(_logical_device->get_vk_handle(), _vk_handle, nullptr); }
+    fence::~fence()
+    {
+        vkDestroyFence(_logical_device->get_vk_handle(), _vk_handle, _logical_device->get_allocation_callbacks(host_object_type::fence));
+    }
 
     void fence::wait_for_fence() { vkWaitForFences(_logical_device->get_vk_handle(), 1, &_vk_handle, VK_TRUE, UINT64_MAX); }
+
+    void fence::reset() { vkResetFences(_logical_device->get_vk_handle(), 1, &_vk_handle); }
+
+    bool fence::is_signaled() const { return vkGetFenceStatus(_logical_device->get_vk_handle(), _vk_handle) == VK_SUCCESS; }
 } // namespace owl::vulkan
\ No newline at end of file
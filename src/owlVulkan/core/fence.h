@@ -14,6 +14,8 @@ namespace owl::vulkan::core
         ~fence();
 
         void wait_for_fence();
+        void reset();
+        bool is_signaled() const;
 
     private:
         std::shared_ptr<logical_device> _logical_device;
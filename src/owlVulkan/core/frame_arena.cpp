@@ -0,0 +1,55 @@
+#include "frame_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace owl::vulkan::core
+{
+    frame_arena::frame_arena(size_t capacity, std::pmr::memory_resource* upstream_resource)
+        : _upstream_resource(upstream_resource)
+        , _capacity(capacity)
+    {
+        _memory = static_cast<std::byte*>(_upstream_resource->allocate(_capacity, alignof(std::max_align_t)));
+        _overflow_allocations.reserve(16);
+    }
+
+    frame_arena::~frame_arena()
+    {
+        reset();
+        _upstream_resource->deallocate(_memory, _capacity, alignof(std::max_align_t));
+    }
+
+    void frame_arena::reset()
+    {
+        for (const auto& allocation : _overflow_allocations)
+            _upstream_resource->deallocate(allocation.memory, allocation.size, allocation.alignment);
+
+        _overflow_allocations.clear();
+        _used_size = 0;
+    }
+
+    void* frame_arena::do_allocate(size_t bytes, size_t alignment)
+    {
+        // the block itself is only aligned for max_align_t, so the address is aligned rather than the offset
+        auto address = reinterpret_cast<std::uintptr_t>(_memory) + _used_size;
+        auto aligned_address = (address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+        size_t offset = static_cast<size_t>(aligned_address - reinterpret_cast<std::uintptr_t>(_memory));
+        if (offset + bytes <= _capacity)
+        {
+            _used_size = offset + bytes;
+            _peak_size = std::max(_peak_size, _used_size);
+            return _memory + offset;
+        }
+
+        ++_overflow_allocations_count;
+
+        void* memory = _upstream_resource->allocate(bytes, alignment);
+        _overflow_allocations.push_back({memory, bytes, alignment});
+
+        return memory;
+    }
+
+    void frame_arena::do_deallocate(void* memory, size_t bytes, size_t alignment) {}
+
+    bool frame_arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept { return this == &other; }
+} // namespace owl::vulkan::core
\ No newline at end of file
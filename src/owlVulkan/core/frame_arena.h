@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace owl::vulkan::core
+{
+    // bump allocator for scratch data that lives at most one frame; deallocation is a no op and everything is released on reset,
+    // requests that do not fit are served by the upstream resource and counted so the capacity can be tuned; a steady state frame
+    // needs no scratch at all, the arena serves the occasional work done inside a frame, such as rebuilding descriptor sets after
+    // resources were moved
+    class frame_arena : public std::pmr::memory_resource
+    {
+    public:
+        static constexpr size_t default_capacity = 256 * 1024;
+
+        explicit frame_arena(size_t capacity = default_capacity,
+                             std::pmr::memory_resource* upstream_resource = std::pmr::new_delete_resource());
+        ~frame_arena() override;
+
+        frame_arena(const frame_arena&) = delete;
+        frame_arena& operator=(const frame_arena&) = delete;
+
+        void reset();
+
+        size_t get_capacity() const { return _capacity; }
+        size_t get_used_size() const { return _used_size; }
+        size_t get_peak_size() const { return _peak_size; }
+        size_t get_overflow_allocations_count() const { return _overflow_allocations_count; }
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* memory, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    private:
+        struct overflow_allocation
+        {
+            void* memory;
+            size_t size;
+            size_t alignment;
+        };
+
+        std::pmr::memory_resource* _upstream_resource;
+        std::byte* _memory;
+        size_t _capacity;
+        size_t _used_size = 0;
+        size_t _peak_size = 0;
+        size_t _overflow_allocations_count = 0;
+        std::vector<overflow_allocation> _overflow_allocations;
+    };
+} // namespace owl::vulkan::core
\ No newline at end of file
@@ -31,9 +31,17 @@ namespace owl::vulkan::core
         framebuffer_info.height = height;
         framebuffer_info.layers = 1;
 
-        auto result = vkCreateFramebuffer(_logical_device->get_vk_handle(), &framebuffer_info, nullptr, &_vk_handle);
+        auto result = vkCreateFramebuffer(_logical_device->get_vk_handle(),
+                                          &framebuffer_info,
+                                          _logical_device->get_allocation_callbacks(host_object_type::framebuffer),
+                                          &_vk_handle);
         vulkan::helpers::handle_result(result, "Failed to create framebuffers");
     }
 
-    framebuffer::~framebuffer() { vkDestroyFramebuffer(_logical_device->get_vk_handle(), _vk_handle, nullptr); }
+    framebuffer::~framebuffer()
+    {
+        vkDestroyFramebuffer(_logical_device->get_vk_handle(),
+                             _vk_handle,
+                             _logical_device->get_allocation_callbacks(host_object_type::framebuffer));
+    }
 } // namespace owl::vulkan::core
\ No newline at end of file
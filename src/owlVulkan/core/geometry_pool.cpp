@@ -0,0 +1,223 @@
+#include "geometry_pool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace owl::vulkan::core
+{
+    geometry_pool::geometry_pool(const std::shared_ptr<memory_allocator>& memory_allocator,
+                                 const std::shared_ptr<logical_device>& logical_device,
+                                 const std::shared_ptr<upload_context>& upload_context,
+                                 const std::shared_ptr<deletion_queue>& deletion_queue,
+                                 uint32_t vertex_stride,
+                                 uint32_t vertices_capacity,
+                                 uint32_t indices_capacity)
+        : _memory_allocator(memory_allocator)
+        , _logical_device(logical_device)
+        , _upload_context(upload_context)
+        , _deletion_queue(deletion_queue)
+        , _vertex_stride(vertex_stride)
+        , _vertex_ranges(vertices_capacity)
+        , _index_ranges(indices_capacity)
+    {
+        VkMemoryPropertyFlags preferred_properties =
+            _memory_allocator->is_unified_memory() ? VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT : 0;
+
+        _vertex_buffer = std::make_shared<buffer>(_memory_allocator,
+                                                  _logical_device,
+                                                  memory_category::mesh,
+                                                  VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                                                      VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                                  VK_SHARING_MODE_EXCLUSIVE,
+                                                  VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                  static_cast<VkDeviceSize>(vertices_capacity) * _vertex_stride,
+                                                  preferred_properties);
+        _index_buffer = std::make_shared<buffer>(_memory_allocator,
+                                                 _logical_device,
+                                                 memory_category::mesh,
+                                                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                                                     VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                                                 VK_SHARING_MODE_EXCLUSIVE,
+                                                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                 static_cast<VkDeviceSize>(indices_capacity) * sizeof(uint32_t),
+                                                 preferred_properties);
+    }
+
+    const mesh_range& geometry_pool::get_mesh_range(mesh_handle handle) const
+    {
+        return _meshes.get(handle);
+    }
+
+    mesh_handle geometry_pool::add(const void* vertices, uint32_t vertex_count, const uint32_t* indices, uint32_t index_count)
+    {
+        if (vertex_count == 0 || index_count == 0)
+            throw std::invalid_argument("Cannot add an empty mesh to a geometry pool.");
+
+        // the ranges were reset when the compaction was recorded, a new range may overlap live data the gpu has not copied yet
+        // or the prefix it copies back; uploads go to the transfer queue, which is not ordered after the graphics queue copies,
+        // so the mesh is only written once the compaction has completed
+        if (is_compacting())
+            _compaction_token.wait();
+
+        auto vertex_offset = _vertex_ranges.allocate(vertex_count, 1);
+        if (!vertex_offset.has_value())
+            throw std::runtime_error("Geometry pool is out of vertex space.");
+
+        auto first_index = _index_ranges.allocate(index_count, 1);
+        if (!first_index.has_value())
+        {
+            _vertex_ranges.free(vertex_offset.value());
+            throw std::runtime_error("Geometry pool is out of index space.");
+        }
+
+        write(*_vertex_buffer,
+              vertices,
+              static_cast<VkDeviceSize>(vertex_count) * _vertex_stride,
+              vertex_offset.value() * _vertex_stride);
+        write(*_index_buffer, indices, static_cast<VkDeviceSize>(index_count) * sizeof(uint32_t), first_index.value() * sizeof(uint32_t));
+
+        mesh_range range{};
+        range.first_index = static_cast<uint32_t>(first_index.value());
+        range.index_count = index_count;
+        range.vertex_offset = static_cast<int32_t>(vertex_offset.value());
+        range.vertex_count = vertex_count;
+
+        return _meshes.create(range);
+    }
+
+    void geometry_pool::remove(mesh_handle handle)
+    {
+        auto range = get_mesh_range(handle);
+        _meshes.destroy(handle);
+
+        // frames in flight may still draw the range, writing a new mesh over it has to wait until they have retired
+        _pending_removals_count++;
+        _deletion_queue->enqueue(
+            [this, range]()
+            {
+                _vertex_ranges.free(static_cast<VkDeviceSize>(range.vertex_offset));
+                _index_ranges.free(range.first_index);
+                _pending_removals_count--;
+            });
+    }
+
+    std::optional<upload_token> geometry_pool::compact()
+    {
+        reclaim();
+
+        // compaction rebuilds the ranges from the live meshes, which pending removals would then free a second time
+        if (_compaction_buffer != nullptr || _pending_removals_count > 0)
+            return std::nullopt;
+
+        std::vector<std::pair<mesh_handle, mesh_range>> meshes;
+        meshes.reserve(_meshes.get_size());
+        _meshes.for_each([&meshes](mesh_handle handle, const mesh_range& range) { meshes.emplace_back(handle, range); });
+
+        std::sort(meshes.begin(), meshes.end(), [](const auto& mesh, const auto& other) {
+            return mesh.second.vertex_offset < other.second.vertex_offset;
+        });
+
+        VkDeviceSize vertices_size = _vertex_ranges.get_used_size() * _vertex_stride;
+        VkDeviceSize indices_size = _index_ranges.get_used_size() * sizeof(uint32_t);
+        if (meshes.empty())
+            return std::nullopt;
+
+        // live ranges are packed into a scratch buffer first, since copies within one buffer must not overlap
+        _compaction_buffer = std::make_shared<buffer>(_memory_allocator,
+                                                      _logical_device,
+                                                      memory_category::mesh,
+                                                      VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                                      VK_SHARING_MODE_EXCLUSIVE,
+                                                      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                      vertices_size + indices_size);
+
+        _vertex_ranges = range_allocator(_vertex_ranges.get_size());
+        _index_ranges = range_allocator(_index_ranges.get_size());
+
+        std::vector<VkBufferCopy> vertex_regions;
+        std::vector<VkBufferCopy> index_regions;
+        vertex_regions.reserve(meshes.size());
+        index_regions.reserve(meshes.size());
+
+        for (auto& [handle, range] : meshes)
+        {
+            VkDeviceSize vertex_offset = _vertex_ranges.allocate(range.vertex_count, 1).value();
+            VkDeviceSize first_index = _index_ranges.allocate(range.index_count, 1).value();
+
+            VkBufferCopy vertex_region{};
+            vertex_region.srcOffset = static_cast<VkDeviceSize>(range.vertex_offset) * _vertex_stride;
+            vertex_region.dstOffset = vertex_offset * _vertex_stride;
+            vertex_region.size = static_cast<VkDeviceSize>(range.vertex_count) * _vertex_stride;
+            vertex_regions.push_back(vertex_region);
+
+            VkBufferCopy index_region{};
+            index_region.srcOffset = static_cast<VkDeviceSize>(range.first_index) * sizeof(uint32_t);
+            index_region.dstOffset = vertices_size + first_index * sizeof(uint32_t);
+            index_region.size = static_cast<VkDeviceSize>(range.index_count) * sizeof(uint32_t);
+            index_regions.push_back(index_region);
+
+            auto& mesh = _meshes.get(handle);
+            mesh.vertex_offset = static_cast<int32_t>(vertex_offset);
+            mesh.first_index = static_cast<uint32_t>(first_index);
+        }
+
+        const VkCommandBuffer& vk_command_buffer = _upload_context->get_vk_graphics_command_buffer();
+
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(
+            vk_command_buffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        vkCmdCopyBuffer(vk_command_buffer,
+                        _vertex_buffer->get_vk_handle(),
+                        _compaction_buffer->get_vk_handle(),
+                        static_cast<uint32_t>(vertex_regions.size()),
+                        vertex_regions.data());
+        vkCmdCopyBuffer(vk_command_buffer,
+                        _index_buffer->get_vk_handle(),
+                        _compaction_buffer->get_vk_handle(),
+                        static_cast<uint32_t>(index_regions.size()),
+                        index_regions.data());
+
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(
+            vk_command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        // packed ranges start at zero, so each buffer gets its whole used prefix back in one copy
+        VkBufferCopy vertices_region{0, 0, vertices_size};
+        vkCmdCopyBuffer(vk_command_buffer, _compaction_buffer->get_vk_handle(), _vertex_buffer->get_vk_handle(), 1, &vertices_region);
+
+        VkBufferCopy indices_region{vertices_size, 0, indices_size};
+        vkCmdCopyBuffer(vk_command_buffer, _compaction_buffer->get_vk_handle(), _index_buffer->get_vk_handle(), 1, &indices_region);
+
+        _compaction_token = _upload_context->submit();
+
+        return _compaction_token;
+    }
+
+    void geometry_pool::reclaim()
+    {
+        if (_compaction_buffer != nullptr && _compaction_token.is_complete())
+            _compaction_buffer = nullptr;
+    }
+
+    bool geometry_pool::is_fragmented() const
+    {
+        return _vertex_ranges.get_free_ranges_count() > 1 || _index_ranges.get_free_ranges_count() > 1;
+    }
+
+    void geometry_pool::write(buffer& destination, const void* values, VkDeviceSize size, VkDeviceSize offset)
+    {
+        if (size == 0)
+            return;
+
+        if (destination.get_mapped_data() != nullptr && destination.is_host_coherent())
+            memcpy(static_cast<char*>(destination.get_mapped_data()) + offset, values, static_cast<size_t>(size));
+        else
+            _upload_context->copy_buffer(destination, values, size, offset);
+    }
+} // namespace owl::vulkan::core
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "buffer.h"
+#include "deletion_queue.h"
+#include "logical_device.h"
+#include "memory_allocator.h"
+#include "mesh_range.h"
+#include "range_allocator.h"
+#include "upload_context.h"
+
+namespace owl::vulkan::core
+{
+    // shared vertex and index buffers that meshes are sub-allocated into, so a scene binds them once and addresses each mesh
+    // with firstIndex / vertexOffset; ranges are counted in elements rather than bytes; a removed mesh's ranges are only reused
+    // once the frames that may still draw it have retired
+    class geometry_pool
+    {
+    public:
+        geometry_pool(const std::shared_ptr<memory_allocator>& memory_allocator,
+                      const std::shared_ptr<logical_device>& logical_device,
+                      const std::shared_ptr<upload_context>& upload_context,
+                      const std::shared_ptr<deletion_queue>& deletion_queue,
+                      uint32_t vertex_stride,
+                      uint32_t vertices_capacity,
+                      uint32_t indices_capacity);
+        ~geometry_pool() = default;
+
+        const std::shared_ptr<buffer>& get_vertex_buffer() const { return _vertex_buffer; }
+        const std::shared_ptr<buffer>& get_index_buffer() const { return _index_buffer; }
+        const mesh_range& get_mesh_range(mesh_handle handle) const;
+
+        mesh_handle add(const void* vertices, uint32_t vertex_count, const uint32_t* indices, uint32_t index_count);
+        void remove(mesh_handle handle);
+        // mesh offsets change as soon as this returns a token, commands recorded from then on must read them again
+        std::optional<upload_token> compact();
+        void reclaim();
+
+        bool is_fragmented() const;
+        bool is_compacting() const { return _compaction_buffer != nullptr && !_compaction_token.is_complete(); }
+
+        template <typename TVertex>
+        mesh_handle add(const std::vector<TVertex>& vertices, const std::vector<uint32_t>& indices)
+        {
+            return add(vertices.data(), static_cast<uint32_t>(vertices.size()), indices.data(), static_cast<uint32_t>(indices.size()));
+        }
+
+    private:
+        std::shared_ptr<memory_allocator> _memory_allocator;
+        std::shared_ptr<logical_device> _logical_device;
+        std::shared_ptr<upload_context> _upload_context;
+        std::shared_ptr<deletion_queue> _deletion_queue;
+        uint32_t _vertex_stride;
+
+        std::shared_ptr<buffer> _vertex_buffer;
+        std::shared_ptr<buffer> _index_buffer;
+        range_allocator _vertex_ranges;
+        range_allocator _index_ranges;
+
+        resource_pool<mesh_range> _meshes;
+        size_t _pending_removals_count = 0;
+
+        std::shared_ptr<buffer> _compaction_buffer;
+        upload_token _compaction_token;
+
+        void write(buffer& destination, const void* values, VkDeviceSize size, VkDeviceSize offset);
+    };
+} // namespace owl::vulkan::core
\ No newline at end of file
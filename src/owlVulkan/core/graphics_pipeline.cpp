@@ -77,12 +77,21 @@ namespace owl::vulkan::core
         graphics_pipeline_info.basePipelineHandle = VK_NULL_HANDLE;
         graphics_pipeline_info.basePipelineIndex = -1;
 
-        auto result =
-            vkCreateGraphicsPipelines(_logical_device->get_vk_handle(), VK_NULL_HANDLE, 1, &graphics_pipeline_info, nullptr, &_vk_handle);
+        auto result = vkCreateGraphicsPipelines(_logical_device->get_vk_handle(),
+                                                VK_NULL_HANDLE,
+                                                1,
+                                                &graphics_pipeline_info,
+                                                _logical_device->get_allocation_callbacks(host_object_type::pipeline),
+                                                &_vk_handle);
         vulkan::helpers::handle_result(result, "Failed to create graphics pipeline");
     }
 
-    graphics_pipeline::~graphics_pipeline() { vkDestroyPipeline(_logical_device->get_vk_handle(), _vk_handle, nullptr); }
+    graphics_pipeline::~graphics_pipeline()
+    {
+        vkDestroyPipeline(_logical_device->get_vk_handle(),
+                          _vk_handle,
+                          _logical_device->get_allocation_callbacks(host_object_type::pipeline));
+    }
 
     VkPipelineShaderStageCreateInfo graphics_pipeline::create_shader_stage_info(const VkShaderModule& shader_module,
                                                                                 VkShaderStageFlagBits shader_stage)
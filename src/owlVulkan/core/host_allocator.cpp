@@ -0,0 +1,315 @@
+#include "host_allocator.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <sstream>
+
+namespace owl::vulkan::core
+{
+    const char* to_string(host_object_type type)
+    {
+        switch (type)
+        {
+        case host_object_type::instance:
+            return "instance";
+        case host_object_type::device:
+            return "device";
+        case host_object_type::surface:
+            return "surface";
+        case host_object_type::swapchain:
+            return "swapchain";
+        case host_object_type::device_memory:
+            return "device_memory";
+        case host_object_type::buffer:
+            return "buffer";
+        case host_object_type::image:
+            return "image";
+        case host_object_type::image_view:
+            return "image_view";
+        case host_object_type::sampler:
+            return "sampler";
+        case host_object_type::framebuffer:
+            return "framebuffer";
+        case host_object_type::render_pass:
+            return "render_pass";
+        case host_object_type::shader_module:
+            return "shader_module";
+        case host_object_type::pipeline_layout:
+            return "pipeline_layout";
+        case host_object_type::pipeline:
+            return "pipeline";
+        case host_object_type::descriptor_set_layout:
+            return "descriptor_set_layout";
+        case host_object_type::descriptor_pool:
+            return "descriptor_pool";
+        case host_object_type::descriptor_update_template:
+            return "descriptor_update_template";
+        case host_object_type::command_pool:
+            return "command_pool";
+        case host_object_type::semaphore:
+            return "semaphore";
+        case host_object_type::fence:
+            return "fence";
+        case host_object_type::debug_messenger:
+            return "debug_messenger";
+        default:
+            return "other";
+        }
+    }
+
+    host_allocation_usage host_allocation_report::get_total() const
+    {
+        host_allocation_usage total{};
+        for (const auto& usage : object_types)
+        {
+            total.allocations_count += usage.allocations_count;
+            total.reallocations_count += usage.reallocations_count;
+            total.frees_count += usage.frees_count;
+            total.live_allocations_count += usage.live_allocations_count;
+            total.live_size += usage.live_size;
+            total.peak_size += usage.peak_size;
+            total.internal_size += usage.internal_size;
+        }
+
+        return total;
+    }
+
+    std::string host_allocation_report::to_json() const
+    {
+        std::ostringstream json;
+        json << "{\"pooled_allocations_count\":" << pooled_allocations_count << ",\"reserved_pool_size\":" << reserved_pool_size
+             << ",\"scopes\":[";
+
+        for (size_t i = 0; i < scope_allocations_count.size(); ++i)
+            json << (i > 0 ? "," : "") << scope_allocations_count[i];
+
+        json << "],\"object_types\":{";
+
+        for (size_t i = 0; i < object_types.size(); ++i)
+        {
+            const auto& usage = object_types[i];
+            json << (i > 0 ? "," : "") << "\"" << to_string(static_cast<host_object_type>(i))
+                 << "\":{\"allocations_count\":" << usage.allocations_count << ",\"reallocations_count\":" << usage.reallocations_count
+                 << ",\"frees_count\":" << usage.frees_count << ",\"live_allocations_count\":" << usage.live_allocations_count
+                 << ",\"live_size\":" << usage.live_size << ",\"peak_size\":" << usage.peak_size
+                 << ",\"internal_size\":" << usage.internal_size << "}";
+        }
+
+        json << "}}";
+
+        return json.str();
+    }
+
+    host_allocator::host_allocator()
+    {
+        for (size_t i = 0; i < _tags.size(); ++i)
+        {
+            _tags[i] = {this, static_cast<host_object_type>(i)};
+
+            _callbacks[i].pUserData = &_tags[i];
+            _callbacks[i].pfnAllocation = allocate_callback;
+            _callbacks[i].pfnReallocation = reallocate_callback;
+            _callbacks[i].pfnFree = free_callback;
+            _callbacks[i].pfnInternalAllocation = internal_allocation_callback;
+            _callbacks[i].pfnInternalFree = internal_free_callback;
+        }
+
+        for (size_t slot_size = min_size_class; slot_size <= max_size_class; slot_size *= 2)
+        {
+            size_class_pool pool{};
+            pool.slot_size = slot_size;
+            _pools.push_back(std::move(pool));
+        }
+    }
+
+    host_allocator::~host_allocator()
+    {
+        // the driver freed everything it allocated before the instance was destroyed, only the pool chunks are left
+        for (const auto& pool : _pools)
+        {
+            for (void* chunk : pool.chunks)
+                ::operator delete(chunk, std::align_val_t(max_size_class));
+        }
+    }
+
+    const VkAllocationCallbacks* host_allocator::get_callbacks(host_object_type type) const
+    {
+        return &_callbacks[static_cast<size_t>(type)];
+    }
+
+    host_allocation_report host_allocator::get_report() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _report;
+    }
+
+    void* host_allocator::allocate(host_object_type type, size_t size, size_t alignment, VkSystemAllocationScope scope)
+    {
+        if (size == 0)
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_report.scope_allocations_count[scope];
+
+        return allocate_locked(type, size, alignment);
+    }
+
+    void* host_allocator::reallocate(host_object_type type, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope)
+    {
+        if (original == nullptr)
+            return allocate(type, size, alignment, scope);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (size == 0)
+        {
+            free_locked(original);
+            return nullptr;
+        }
+
+        auto& record = get_record(original);
+        auto& usage = _report.object_types[static_cast<size_t>(record.type)];
+        ++usage.reallocations_count;
+
+        // a slot already large enough is grown in place
+        if (record.size_class_index != no_size_class && find_size_class(size, alignment) == record.size_class_index)
+        {
+            usage.live_size = usage.live_size - record.size + size;
+            usage.peak_size = std::max(usage.peak_size, usage.live_size);
+            record.size = size;
+            return original;
+        }
+
+        ++_report.scope_allocations_count[scope];
+
+        size_t original_size = record.size;
+        void* memory = allocate_locked(type, size, alignment);
+        if (memory == nullptr)
+            return nullptr;
+
+        memcpy(memory, original, std::min(original_size, size));
+        free_locked(original);
+
+        return memory;
+    }
+
+    void host_allocator::free(void* memory)
+    {
+        if (memory == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        free_locked(memory);
+    }
+
+    void* host_allocator::allocate_locked(host_object_type type, size_t size, size_t alignment)
+    {
+        size_t header_size = get_header_size(alignment);
+        size_t size_class_index = find_size_class(size, alignment);
+        void* block = nullptr;
+
+        if (size_class_index != no_size_class)
+        {
+            auto& pool = _pools[size_class_index];
+            if (pool.free_slots.empty())
+            {
+                void* chunk = ::operator new(chunk_size, std::align_val_t(max_size_class), std::nothrow);
+                if (chunk == nullptr)
+                    return nullptr;
+
+                pool.chunks.push_back(chunk);
+                _report.reserved_pool_size += chunk_size;
+
+                for (size_t offset = chunk_size; offset >= pool.slot_size; offset -= pool.slot_size)
+                    pool.free_slots.push_back(static_cast<char*>(chunk) + offset - pool.slot_size);
+            }
+
+            block = pool.free_slots.back();
+            pool.free_slots.pop_back();
+            ++_report.pooled_allocations_count;
+        }
+        else
+        {
+            block = ::operator new(header_size + size, std::align_val_t(header_size), std::nothrow);
+            if (block == nullptr)
+                return nullptr;
+        }
+
+        void* memory = static_cast<char*>(block) + header_size;
+        get_record(memory) = {size, alignment, size_class_index, static_cast<uint32_t>(header_size), type};
+
+        auto& usage = _report.object_types[static_cast<size_t>(type)];
+        ++usage.allocations_count;
+        ++usage.live_allocations_count;
+        usage.live_size += size;
+        usage.peak_size = std::max(usage.peak_size, usage.live_size);
+
+        return memory;
+    }
+
+    void host_allocator::free_locked(void* memory)
+    {
+        const auto record = get_record(memory);
+        auto& usage = _report.object_types[static_cast<size_t>(record.type)];
+        ++usage.frees_count;
+        --usage.live_allocations_count;
+        usage.live_size -= record.size;
+
+        void* block = static_cast<char*>(memory) - record.header_size;
+        if (record.size_class_index != no_size_class)
+            _pools[record.size_class_index].free_slots.push_back(block);
+        else
+            ::operator delete(block, std::align_val_t(record.header_size));
+    }
+
+    size_t host_allocator::find_size_class(size_t size, size_t alignment) const
+    {
+        // slots are aligned to their size, so a slot that fits the header and the allocation also honours its alignment
+        size_t slot_size = get_header_size(alignment) + size;
+        for (size_t i = 0; i < _pools.size(); ++i)
+        {
+            if (slot_size <= _pools[i].slot_size)
+                return i;
+        }
+
+        return no_size_class;
+    }
+
+    void* host_allocator::allocate_callback(void* user_data, size_t size, size_t alignment, VkSystemAllocationScope scope)
+    {
+        auto tag = static_cast<host_allocator::tag*>(user_data);
+        return tag->allocator->allocate(tag->type, size, alignment, scope);
+    }
+
+    void* host_allocator::reallocate_callback(void* user_data, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope)
+    {
+        auto tag = static_cast<host_allocator::tag*>(user_data);
+        return tag->allocator->reallocate(tag->type, original, size, alignment, scope);
+    }
+
+    void host_allocator::free_callback(void* user_data, void* memory)
+    {
+        auto tag = static_cast<host_allocator::tag*>(user_data);
+        tag->allocator->free(memory);
+    }
+
+    void host_allocator::internal_allocation_callback(void* user_data,
+                                                      size_t size,
+                                                      VkInternalAllocationType type,
+                                                      VkSystemAllocationScope scope)
+    {
+        auto tag = static_cast<host_allocator::tag*>(user_data);
+
+        std::lock_guard<std::mutex> lock(tag->allocator->_mutex);
+        tag->allocator->_report.object_types[static_cast<size_t>(tag->type)].internal_size += size;
+    }
+
+    void host_allocator::internal_free_callback(void* user_data, size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope)
+    {
+        auto tag = static_cast<host_allocator::tag*>(user_data);
+
+        std::lock_guard<std::mutex> lock(tag->allocator->_mutex);
+        tag->allocator->_report.object_types[static_cast<size_t>(tag->type)].internal_size -= size;
+    }
+} // namespace owl::vulkan::core
\ No newline at end of file
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace owl::vulkan::core
+{
+    enum class host_object_type
+    {
+        instance,
+        device,
+        surface,
+        swapchain,
+        device_memory,
+        buffer,
+        image,
+        image_view,
+        sampler,
+        framebuffer,
+        render_pass,
+        shader_module,
+        pipeline_layout,
+        pipeline,
+        descriptor_set_layout,
+        descriptor_pool,
+        descriptor_update_template,
+        command_pool,
+        semaphore,
+        fence,
+        debug_messenger,
+        other,
+        count
+    };
+
+    const char* to_string(host_object_type type);
+
+    struct host_allocation_usage
+    {
+        size_t allocations_count = 0;
+        size_t reallocations_count = 0;
+        size_t frees_count = 0;
+        size_t live_allocations_count = 0;
+        size_t live_size = 0;
+        size_t peak_size = 0;
+        size_t internal_size = 0;
+    };
+
+    constexpr size_t system_allocation_scopes_count = VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE + 1;
+
+    struct host_allocation_report
+    {
+        std::array<host_allocation_usage, static_cast<size_t>(host_object_type::count)> object_types{};
+        std::array<size_t, system_allocation_scopes_count> scope_allocations_count{};
+        size_t pooled_allocations_count = 0;
+        size_t reserved_pool_size = 0;
+
+        host_allocation_usage get_total() const;
+        std::string to_json() const;
+    };
+
+    // vulkan host allocation callbacks tagged by the type of object being created; small allocations are served from size class
+    // pools so the driver churn of recreating objects does not reach the general purpose heap; each allocation carries its record
+    // in a header right before the returned memory, so tracking it never allocates either
+    class host_allocator
+    {
+    public:
+        static constexpr size_t min_size_class = 16;
+        static constexpr size_t max_size_class = 4096;
+        static constexpr size_t chunk_size = 64 * 1024;
+
+        host_allocator();
+        ~host_allocator();
+
+        host_allocator(const host_allocator&) = delete;
+        host_allocator& operator=(const host_allocator&) = delete;
+
+        const VkAllocationCallbacks* get_callbacks(host_object_type type) const;
+        host_allocation_report get_report() const;
+
+    private:
+        struct tag
+        {
+            host_allocator* allocator;
+            host_object_type type;
+        };
+
+        struct allocation_record
+        {
+            size_t size;
+            size_t alignment;
+            size_t size_class_index;
+            uint32_t header_size;
+            host_object_type type;
+        };
+
+        // a power of two, so a header of max(alignment, record_size) bytes keeps the returned memory aligned
+        static constexpr size_t record_size = 32;
+        static_assert(sizeof(allocation_record) <= record_size);
+
+        struct size_class_pool
+        {
+            size_t slot_size = 0;
+            std::vector<void*> free_slots;
+            std::vector<void*> chunks;
+        };
+
+        static constexpr size_t no_size_class = static_cast<size_t>(-1);
+
+        std::array<tag, static_cast<size_t>(host_object_type::count)> _tags;
+        std::array<VkAllocationCallbacks, static_cast<size_t>(host_object_type::count)> _callbacks;
+        std::vector<size_class_pool> _pools;
+
+        mutable std::mutex _mutex;
+        host_allocation_report _report;
+
+        void* allocate(host_object_type type, size_t size, size_t alignment, VkSystemAllocationScope scope);
+        void* reallocate(host_object_type type, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope);
+        void free(void* memory);
+
+        void* allocate_locked(host_object_type type, size_t size, size_t alignment);
+        void free_locked(void* memory);
+        size_t find_size_class(size_t size, size_t alignment) const;
+        static size_t get_header_size(size_t alignment) { return std::max(alignment, record_size); }
+        static allocation_record& get_record(void* memory)
+        {
+            return *reinterpret_cast<allocation_record*>(static_cast<char*>(memory) - record_size);
+        }
+
+        static VKAPI_ATTR void* VKAPI_CALL allocate_callback(void* user_data,
+                                                             size_t size,
+                                                             size_t alignment,
+                                                             VkSystemAllocationScope scope);
+        static VKAPI_ATTR void* VKAPI_CALL reallocate_callback(void* user_data,
+                                                               void* original,
+                                                               size_t size,
+                                                               size_t alignment,
+                                                               VkSystemAllocationScope scope);
+        static VKAPI_ATTR void VKAPI_CALL free_callback(void* user_data, void* memory);
+        static VKAPI_ATTR void VKAPI_CALL internal_allocation_callback(void* user_data,
+                                                                       size_t size,
+                                                                       VkInternalAllocationType type,
+                                                                       VkSystemAllocationScope scope);
+        static VKAPI_ATTR void VKAPI_CALL internal_free_callback(void* user_data,
+                                                                 size_t size,
+                                                                 VkInternalAllocationType type,
+                                                                 VkSystemAllocationScope scope);
+    };
+} // namespace owl::vulkan::core
\ No newline at end of file
@@ -1,12 +1,16 @@
 #include "image.h"
 
-#include "command_buffers.h"
+#include <algorithm>
+#include <vector>
+
+#include "staging_belt.h"
 #include "vulkan_helpers.h"
 
 namespace owl::vulkan::core
 {
-    image::image(const std::shared_ptr<physical_device>& physical_device,
+    image::image(const std::shared_ptr<memory_allocator>& memory_allocator,
                  const std::shared_ptr<logical_device>& logical_device,
+                 memory_category category,
                  const uint32_t width,
                  const uint32_t height,
                  const uint32_t mip_levels,
@@ -14,13 +18,117 @@ namespace owl::vulkan::core
                  VkFormat format,
                  VkImageTiling tiling,
                  VkImageUsageFlags usage,
-                 VkMemoryPropertyFlags properties)
+                 VkMemoryPropertyFlags properties,
+                 VkMemoryPropertyFlags preferred_properties)
         : _logical_device(logical_device)
+        , _memory_allocator(memory_allocator)
         , _format(format)
         , _layout(VK_IMAGE_LAYOUT_UNDEFINED)
         , _width(width)
         , _height(height)
         , _mip_levels(mip_levels)
+        , _samples(samples)
+        , _tiling(tiling)
+        , _usage(usage)
+    {
+        _vk_handle = create_vk_image();
+
+        VkMemoryRequirements memory_requirements;
+        vkGetImageMemoryRequirements(_logical_device->get_vk_handle(), _vk_handle, &memory_requirements);
+
+        auto memory_tiling = tiling == VK_IMAGE_TILING_LINEAR ? resource_tiling::linear : resource_tiling::optimal;
+        _memory_allocation = _memory_allocator->allocate(memory_requirements, properties, memory_tiling, category, preferred_properties);
+        vkBindImageMemory(_logical_device->get_vk_handle(),
+                          _vk_handle,
+                          _memory_allocation.get_vk_device_memory(),
+                          _memory_allocation.offset);
+    }
+
+    image::~image()
+    {
+        release_retired();
+
+        vkDestroyImage(_logical_device->get_vk_handle(), _vk_handle, _logical_device->get_allocation_callbacks(host_object_type::image));
+        _memory_allocator->free(_memory_allocation);
+    }
+
+    bool image::is_movable() const
+    {
+        bool is_transferable = (_usage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) && (_usage & VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+        return is_transferable && _samples == VK_SAMPLE_COUNT_1_BIT && _layout != VK_IMAGE_LAYOUT_UNDEFINED
+               && _retired_vk_handle == VK_NULL_HANDLE;
+    }
+
+    bool image::move(const VkCommandBuffer& vk_command_buffer)
+    {
+        VkImage new_vk_handle = create_vk_image();
+
+        VkMemoryRequirements memory_requirements;
+        vkGetImageMemoryRequirements(_logical_device->get_vk_handle(), new_vk_handle, &memory_requirements);
+
+        auto new_allocation = _memory_allocator->reallocate(_memory_allocation, memory_requirements);
+        if (!new_allocation.has_value())
+        {
+            vkDestroyImage(_logical_device->get_vk_handle(),
+                           new_vk_handle,
+                           _logical_device->get_allocation_callbacks(host_object_type::image));
+            return false;
+        }
+
+        vkBindImageMemory(_logical_device->get_vk_handle(), new_vk_handle, new_allocation->get_vk_device_memory(), new_allocation->offset);
+
+        record_barrier(vk_command_buffer, _vk_handle, _mip_levels, _layout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+        record_barrier(vk_command_buffer, new_vk_handle, _mip_levels, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+        std::vector<VkImageCopy> regions(_mip_levels);
+        for (uint32_t i = 0; i < _mip_levels; ++i)
+        {
+            regions[i].srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            regions[i].srcSubresource.mipLevel = i;
+            regions[i].srcSubresource.baseArrayLayer = 0;
+            regions[i].srcSubresource.layerCount = 1;
+            regions[i].dstSubresource = regions[i].srcSubresource;
+            regions[i].extent.width = std::max(_width >> i, 1u);
+            regions[i].extent.height = std::max(_height >> i, 1u);
+            regions[i].extent.depth = 1;
+        }
+
+        vkCmdCopyImage(vk_command_buffer,
+                       _vk_handle,
+                       VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                       new_vk_handle,
+                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                       static_cast<uint32_t>(regions.size()),
+                       regions.data());
+
+        // frames recorded before the owner rebuilt its views still sample the old image in its original layout
+        record_barrier(vk_command_buffer, _vk_handle, _mip_levels, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, _layout);
+        record_barrier(vk_command_buffer, new_vk_handle, _mip_levels, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, _layout);
+
+        // image views still reference the old image, so it is only released once they have been recreated
+        _retired_vk_handle = _vk_handle;
+        _retired_memory_allocation = _memory_allocation;
+        _vk_handle = new_vk_handle;
+        _memory_allocation = new_allocation.value();
+
+        return true;
+    }
+
+    void image::release_retired()
+    {
+        if (_retired_vk_handle == VK_NULL_HANDLE)
+            return;
+
+        vkDestroyImage(_logical_device->get_vk_handle(),
+                       _retired_vk_handle,
+                       _logical_device->get_allocation_callbacks(host_object_type::image));
+        _memory_allocator->free(_retired_memory_allocation);
+
+        _retired_vk_handle = VK_NULL_HANDLE;
+        _retired_memory_allocation = {};
+    }
+
+    VkImage image::create_vk_image() const
     {
         VkImageCreateInfo image_info{};
         image_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
@@ -28,40 +136,60 @@ namespace owl::vulkan::core
         image_info.extent.width = _width;
         image_info.extent.height = _height;
         image_info.extent.depth = 1;
-        image_info.mipLevels = mip_levels;
+        image_info.mipLevels = _mip_levels;
         image_info.arrayLayers = 1;
         image_info.format = _format;
-        image_info.tiling = tiling;
-        image_info.initialLayout = _layout;
-        image_info.usage = usage;
+        image_info.tiling = _tiling;
+        image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        image_info.usage = _usage;
         image_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-        image_info.samples = samples;
+        image_info.samples = _samples;
         image_info.flags = 0;
 
-        auto result = vkCreateImage(_logical_device->get_vk_handle(), &image_info, nullptr, &_vk_handle);
+        VkImage vk_image;
+        auto result = vkCreateImage(_logical_device->get_vk_handle(),
+                                    &image_info,
+                                    _logical_device->get_allocation_callbacks(host_object_type::image),
+                                    &vk_image);
         helpers::handle_result(result, "Failed to create image.");
 
-        VkMemoryRequirements memory_requirements;
-        vkGetImageMemoryRequirements(_logical_device->get_vk_handle(), _vk_handle, &memory_requirements);
-
-        _device_memory = std::make_unique<device_memory>(physical_device, _logical_device, memory_requirements, properties);
-        vkBindImageMemory(_logical_device->get_vk_handle(), _vk_handle, _device_memory->get_vk_handle(), 0);
+        return vk_image;
     }
 
-    image::~image() { vkDestroyImage(_logical_device->get_vk_handle(), _vk_handle, nullptr); }
-
-    void image::transition_layout(const std::shared_ptr<command_pool>& command_pool, VkImageLayout new_layout)
+    void image::record_barrier(const VkCommandBuffer& vk_command_buffer,
+                               VkImage vk_image,
+                               uint32_t mip_levels,
+                               VkImageLayout old_layout,
+                               VkImageLayout new_layout)
     {
-        command_buffers command_buffers(_logical_device, command_pool, 1);
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.oldLayout = old_layout;
+        barrier.newLayout = new_layout;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = vk_image;
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.baseMipLevel = 0;
+        barrier.subresourceRange.levelCount = mip_levels;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount = 1;
+        barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
 
-        command_buffers.process_command_buffers(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
-                                                [this, new_layout](const VkCommandBuffer& vk_command_buffer, size_t index) {
-                                                    process_transition_layout(new_layout, vk_command_buffer);
-                                                });
-        _logical_device->submit_to_graphics_queue(command_buffers);
+        vkCmdPipelineBarrier(vk_command_buffer,
+                             VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                             VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr,
+                             1,
+                             &barrier);
     }
 
-    void image::process_transition_layout(VkImageLayout new_layout, const VkCommandBuffer& vk_command_buffer)
+    void image::transition_layout(const VkCommandBuffer& vk_command_buffer, VkImageLayout new_layout)
     {
         VkImageMemoryBarrier barrier{};
         barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
@@ -103,21 +231,10 @@ namespace owl::vulkan::core
         _layout = new_layout;
     }
 
-    void image::copy_buffer(const std::shared_ptr<command_pool>& command_pool, const VkBuffer& source_buffer)
-    {
-        command_buffers command_buffers(_logical_device, command_pool, 1);
-
-        command_buffers.process_command_buffers(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
-                                                [this, &source_buffer](const VkCommandBuffer& vk_command_buffer, size_t index) {
-                                                    copy_buffer(vk_command_buffer, source_buffer);
-                                                });
-        _logical_device->submit_to_graphics_queue(command_buffers);
-    }
-
-    void image::copy_buffer(const VkCommandBuffer& vk_command_buffer, const VkBuffer& source_buffer)
+    void image::copy_buffer(const VkCommandBuffer& vk_command_buffer, const staging_region& source_region)
     {
         VkBufferImageCopy region{};
-        region.bufferOffset = 0;
+        region.bufferOffset = source_region.offset;
         region.bufferRowLength = 0;
         region.bufferImageHeight = 0;
         region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -127,19 +244,10 @@ namespace owl::vulkan::core
         region.imageOffset = {0, 0, 0};
         region.imageExtent = {_width, _height, 1};
 
-        vkCmdCopyBufferToImage(vk_command_buffer, source_buffer, _vk_handle, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+        vkCmdCopyBufferToImage(vk_command_buffer, source_region.buffer, _vk_handle, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
     }
 
-    void image::generate_mipmaps(const std::shared_ptr<command_pool>& command_pool)
-    {
-        command_buffers command_buffers(_logical_device, command_pool, 1);
-        command_buffers.process_command_buffers(
-            VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
-            [this](const VkCommandBuffer& vk_command_buffer, size_t index) { process_mipmaps_generation(vk_command_buffer); });
-        _logical_device->submit_to_graphics_queue(command_buffers);
-    }
-
-    void image::process_mipmaps_generation(const VkCommandBuffer& vk_command_buffer)
+    void image::generate_mipmaps(const VkCommandBuffer& vk_command_buffer)
     {
         VkImageMemoryBarrier barrier{};
         barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
@@ -234,5 +342,7 @@ namespace owl::vulkan::core
                              nullptr,
                              1,
                              &barrier);
+
+        _layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
     }
 } // namespace owl::vulkan
\ No newline at end of file
@@ -4,19 +4,21 @@
 
 #include <memory>
 
-#include "command_pool.h"
 #include "device_memory.h"
 #include "logical_device.h"
-#include "physical_device.h"
+#include "memory_allocator.h"
 #include "vulkan_object.h"
 
 namespace owl::vulkan::core
 {
+    struct staging_region;
+
     class image : public vulkan_object<VkImage>
     {
     public:
-        image(const std::shared_ptr<physical_device>& physical_device,
+        image(const std::shared_ptr<memory_allocator>& memory_allocator,
               const std::shared_ptr<logical_device>& logical_device,
+              memory_category category,
               const uint32_t width,
               const uint32_t height,
               const uint32_t mip_levels,
@@ -24,28 +26,47 @@ namespace owl::vulkan::core
               VkFormat format,
               VkImageTiling tiling,
               VkImageUsageFlags usage,
-              VkMemoryPropertyFlags properties);
+              VkMemoryPropertyFlags properties,
+              VkMemoryPropertyFlags preferred_properties = 0);
 
         image(image&&) = default;
         ~image();
 
         VkFormat get_format() const { return _format; }
+        VkImageLayout get_layout() const { return _layout; }
+        uint32_t get_mip_levels() const { return _mip_levels; }
+
+        void transition_layout(const VkCommandBuffer& vk_command_buffer, VkImageLayout new_layout);
+        void copy_buffer(const VkCommandBuffer& vk_command_buffer, const staging_region& source_region);
+        void generate_mipmaps(const VkCommandBuffer& vk_command_buffer);
 
-        void transition_layout(const std::shared_ptr<command_pool>& command_pool, VkImageLayout new_layout);
-        void copy_buffer(const std::shared_ptr<command_pool>& command_pool, const VkBuffer& source_buffer);
-        void generate_mipmaps(const std::shared_ptr<command_pool>& command_pool);
+        bool is_movable() const;
+        const memory_block* get_memory_block() const { return _memory_allocation.block; }
+        VkDeviceSize get_memory_size() const { return _memory_allocation.size; }
+        bool move(const VkCommandBuffer& vk_command_buffer);
+        void release_retired();
 
     private:
         std::shared_ptr<logical_device> _logical_device;
-        std::unique_ptr<device_memory> _device_memory;
+        std::shared_ptr<memory_allocator> _memory_allocator;
+        memory_allocation _memory_allocation;
         VkFormat _format;
         VkImageLayout _layout;
         uint32_t _width;
         uint32_t _height;
         uint32_t _mip_levels;
+        VkSampleCountFlagBits _samples;
+        VkImageTiling _tiling;
+        VkImageUsageFlags _usage;
+
+        VkImage _retired_vk_handle = VK_NULL_HANDLE;
+        memory_allocation _retired_memory_allocation;
 
-        void process_transition_layout(VkImageLayout new_layout, const VkCommandBuffer& vk_command_buffer);
-        void copy_buffer(const VkCommandBuffer& vk_command_buffer, const VkBuffer& source_buffer);
-        void process_mipmaps_generation(const VkCommandBuffer& vk_command_buffer);
+        VkImage create_vk_image() const;
+        static void record_barrier(const VkCommandBuffer& vk_command_buffer,
+                                   VkImage vk_image,
+                                   uint32_t mip_levels,
+                                   VkImageLayout old_layout,
+                                   VkImageLayout new_layout);
     };
 } // namespace owl::vulkan
\ No newline at end of file
@@ -26,9 +26,17 @@ namespace owl::vulkan::core
         create_info.subresourceRange.baseArrayLayer = 0;
         create_info.subresourceRange.layerCount = 1;
 
-        auto result = vkCreateImageView(_logical_device->get_vk_handle(), &create_info, nullptr, &_vk_handle);
+        auto result = vkCreateImageView(_logical_device->get_vk_handle(),
+                                        &create_info,
+                                        _logical_device->get_allocation_callbacks(host_object_type::image_view),
+                                        &_vk_handle);
         vulkan::helpers::handle_result(result, "Failed to create image view");
     }
 
-    image_view::~image_view() { vkDestroyImageView(_logical_device->get_vk_handle(), _vk_handle, nullptr); }
+    image_view::~image_view()
+    {
+        vkDestroyImageView(_logical_device->get_vk_handle(),
+                           _vk_handle,
+                           _logical_device->get_allocation_callbacks(host_object_type::image_view));
+    }
 } // namespace owl::vulkan
\ No newline at end of file
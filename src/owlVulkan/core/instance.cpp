@@ -14,7 +14,9 @@ namespace owl::vulkan::core
 {
     instance::instance(bool enable_validation_layers,
                        const std::vector<const char*>& validation_layers,
-                       const std::vector<const char*>& required_extensions)
+                       const std::vector<const char*>& required_extensions,
+                       const std::shared_ptr<host_allocator>& host_allocator)
+        : _host_allocator(host_allocator)
     {
         if (enable_validation_layers && !check_validation_layer_support(validation_layers))
             throw std::runtime_error("Validation layers requested but some are not available.");
@@ -25,7 +27,7 @@ namespace owl::vulkan::core
         application_info.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
         application_info.pEngineName = "No engine";
         application_info.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-        application_info.apiVersion = VK_API_VERSION_1_0;
+        application_info.apiVersion = _api_version = query_api_version();
 
         VkInstanceCreateInfo create_info{};
         create_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -56,17 +58,19 @@ namespace owl::vulkan::core
             create_info.pNext = nullptr;
         }
 
-        VkResult result = vkCreateInstance(&create_info, nullptr, &_vk_handle);
+        VkResult result = vkCreateInstance(&create_info, get_allocation_callbacks(host_object_type::instance), &_vk_handle);
         vulkan::helpers::handle_result(result, "Failed to create instance");
 
+        _enabled_extensions.assign(required_extensions.begin(), required_extensions.end());
+
         if (enable_validation_layers)
-            _debug_messenger = std::make_unique<debug_messenger>(_vk_handle);
+            _debug_messenger = std::make_unique<debug_messenger>(_vk_handle, get_allocation_callbacks(host_object_type::debug_messenger));
     }
 
     instance::~instance()
     {
         _debug_messenger = nullptr;
-        vkDestroyInstance(_vk_handle, nullptr);
+        vkDestroyInstance(_vk_handle, get_allocation_callbacks(host_object_type::instance));
     }
 
     bool instance::check_validation_layer_support(const std::vector<const char*>& validation_layers)
@@ -97,4 +101,23 @@ namespace owl::vulkan::core
 
         return helpers::getElements<VkPhysicalDevice>(function);
     }
+
+    uint32_t instance::query_api_version()
+    {
+        // vkEnumerateInstanceVersion is missing from 1.0 loaders; 1.2 is requested when available for timeline semaphores
+        auto enumerate_instance_version = (PFN_vkEnumerateInstanceVersion)vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceVersion");
+        if (enumerate_instance_version == nullptr)
+            return VK_API_VERSION_1_0;
+
+        uint32_t api_version = VK_API_VERSION_1_0;
+        if (enumerate_instance_version(&api_version) != VK_SUCCESS)
+            return VK_API_VERSION_1_0;
+
+        return std::min(api_version, static_cast<uint32_t>(VK_API_VERSION_1_2));
+    }
+
+    bool instance::is_extension_enabled(const char* extension_name) const
+    {
+        return std::find(_enabled_extensions.begin(), _enabled_extensions.end(), extension_name) != _enabled_extensions.end();
+    }
 } // namespace owl::vulkan
\ No newline at end of file
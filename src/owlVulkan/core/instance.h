@@ -3,9 +3,11 @@
 #include <vulkan/vulkan.h>
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "debug_messenger.h"
+#include "host_allocator.h"
 #include "vulkan_object.h"
 
 namespace owl::vulkan::core
@@ -15,15 +17,25 @@ namespace owl::vulkan::core
     public:
         instance(bool enable_validation_layers,
                  const std::vector<const char*>& validation_layers,
-                 const std::vector<const char*>& required_extensions);
+                 const std::vector<const char*>& required_extensions,
+                 const std::shared_ptr<host_allocator>& host_allocator);
 
         ~instance();
 
         std::vector<VkPhysicalDevice> get_physical_devices();
+        bool is_extension_enabled(const char* extension_name) const;
+        uint32_t get_api_version() const { return _api_version; }
+
+        const std::shared_ptr<host_allocator>& get_host_allocator() const { return _host_allocator; }
+        const VkAllocationCallbacks* get_allocation_callbacks(host_object_type type) const { return _host_allocator->get_callbacks(type); }
 
     private:
+        std::shared_ptr<host_allocator> _host_allocator;
         std::unique_ptr<debug_messenger> _debug_messenger;
+        std::vector<std::string> _enabled_extensions;
+        uint32_t _api_version = VK_API_VERSION_1_0;
 
+        static uint32_t query_api_version();
         bool check_validation_layer_support(const std::vector<const char*>& validation_layers);
     };
 } // namespace owl::vulkan
\ No newline at end of file
@@ -4,7 +4,6 @@
 #include <vector>
 
 #include "../helpers/vulkan_helpers.h"
-#include "command_buffers.h"
 #include "queue_families_indices.h"
 
 namespace owl::vulkan::core
@@ -13,29 +12,40 @@ namespace owl::vulkan::core
                                    const std::shared_ptr<surface>& surface,
                                    const std::vector<const char*>& device_extensions,
                                    const std::vector<const char*>& validation_layers,
-                                   bool enable_validation_layers)
+                                   bool enable_validation_layers,
+                                   const std::shared_ptr<host_allocator>& host_allocator,
+                                   bool enable_timeline_semaphores,
+                                   bool enable_descriptor_indexing)
+        : _host_allocator(host_allocator)
+        , _is_timeline_semaphore_enabled(enable_timeline_semaphores)
+        , _is_descriptor_indexing_enabled(enable_descriptor_indexing)
     {
-        vulkan::queue_families_indices indices = physical_device->find_queue_families();
+        _queue_families_indices = physical_device->find_queue_families();
+        const auto& indices = _queue_families_indices;
 
-        std::set<uint32_t> unique_queue_families{indices.graphics_family.value(), indices.presentation_family.value()};
+        std::set<uint32_t> unique_queue_families{indices.graphics_family.value(),
+                                                 indices.presentation_family.value(),
+                                                 indices.transfer_family.value()};
         std::vector<VkDeviceQueueCreateInfo> queue_create_infos;
         queue_create_infos.reserve(unique_queue_families.size());
 
-        float queue_priority = 1.0f;
+        float queue_priorities[] = {1.0f, 1.0f};
 
         for (uint32_t queue_family : unique_queue_families)
         {
             VkDeviceQueueCreateInfo queue_create_info{};
             queue_create_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
             queue_create_info.queueFamilyIndex = queue_family;
-            queue_create_info.queueCount = 1;
-            queue_create_info.pQueuePriorities = &queue_priority;
+            queue_create_info.queueCount = queue_family == indices.transfer_family ? indices.transfer_queue_index + 1 : 1;
+            queue_create_info.pQueuePriorities = queue_priorities;
             queue_create_infos.push_back(queue_create_info);
         }
 
         VkPhysicalDeviceFeatures device_features{};
         device_features.samplerAnisotropy = VK_TRUE;
         device_features.sampleRateShading = VK_TRUE;
+        // the bindless fragment shader picks its texture with an index read from the material table
+        device_features.shaderSampledImageArrayDynamicIndexing = enable_descriptor_indexing ? VK_TRUE : VK_FALSE;
 
         VkDeviceCreateInfo create_info{};
         create_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -45,6 +55,26 @@ namespace owl::vulkan::core
         create_info.enabledExtensionCount = static_cast<uint32_t>(device_extensions.size());
         create_info.ppEnabledExtensionNames = device_extensions.data();
 
+        VkPhysicalDeviceTimelineSemaphoreFeatures timeline_features{};
+        timeline_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+        timeline_features.timelineSemaphore = VK_TRUE;
+        if (enable_timeline_semaphores)
+            create_info.pNext = &timeline_features;
+
+        // only what bindless tables rely on: sampler indices stay dynamically uniform, so non uniform indexing is not needed
+        VkPhysicalDeviceDescriptorIndexingFeatures indexing_features{};
+        indexing_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+        indexing_features.runtimeDescriptorArray = VK_TRUE;
+        indexing_features.descriptorBindingPartiallyBound = VK_TRUE;
+        indexing_features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        indexing_features.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+        indexing_features.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+        if (enable_descriptor_indexing)
+        {
+            indexing_features.pNext = const_cast<void*>(create_info.pNext);
+            create_info.pNext = &indexing_features;
+        }
+
         if (enable_validation_layers)
         {
             create_info.enabledLayerCount = static_cast<uint32_t>(validation_layers.size());
@@ -53,26 +83,19 @@ namespace owl::vulkan::core
         else
             create_info.enabledLayerCount = 0;
 
-        auto result = vkCreateDevice(physical_device->get_vk_handle(), &create_info, nullptr, &_vk_handle);
+        auto result = vkCreateDevice(physical_device->get_vk_handle(),
+                                     &create_info,
+                                     get_allocation_callbacks(host_object_type::device),
+                                     &_vk_handle);
         vulkan::helpers::handle_result(result, "Failed to create logical device");
 
         vkGetDeviceQueue(_vk_handle, indices.graphics_family.value(), 0, &_vk_graphics_queue);
         vkGetDeviceQueue(_vk_handle, indices.presentation_family.value(), 0, &_vk_presentation_queue);
+        vkGetDeviceQueue(_vk_handle, indices.transfer_family.value(), indices.transfer_queue_index, &_vk_transfer_queue);
     }
 
-    logical_device::~logical_device() { vkDestroyDevice(_vk_handle, nullptr); }
+    logical_device::~logical_device() { vkDestroyDevice(_vk_handle, get_allocation_callbacks(host_object_type::device)); }
 
     void logical_device::wait_idle() { vkDeviceWaitIdle(_vk_handle); }
 
-    void logical_device::submit_to_graphics_queue(const command_buffers& command_buffers)
-    {
-        VkSubmitInfo submit_info{};
-        submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submit_info.commandBufferCount = 1;
-        submit_info.pCommandBuffers = command_buffers.get_vk_command_buffers().data();
-
-        vkQueueSubmit(_vk_graphics_queue, 1, &submit_info, VK_NULL_HANDLE);
-        vkQueueWaitIdle(_vk_graphics_queue);
-    }
-
 } // namespace owl::vulkan
\ No newline at end of file
@@ -4,14 +4,13 @@
 
 #include <memory>
 
+#include "host_allocator.h"
 #include "physical_device.h"
 #include "surface.h"
 #include "vulkan_object.h"
 
 namespace owl::vulkan::core
 {
-    class command_buffers;
-
     class logical_device : public vulkan_object<VkDevice>
     {
     public:
@@ -19,17 +18,29 @@ namespace owl::vulkan::core
                        const std::shared_ptr<surface>& surface,
                        const std::vector<const char*>& device_extensions,
                        const std::vector<const char*>& validation_layers,
-                       bool enable_validation_layers);
+                       bool enable_validation_layers,
+                       const std::shared_ptr<host_allocator>& host_allocator,
+                       bool enable_timeline_semaphores = false,
+                       bool enable_descriptor_indexing = false);
         ~logical_device();
 
         const VkQueue& get_vk_graphics_queue() const { return _vk_graphics_queue; }
         const VkQueue& get_vk_presentation_queue() const { return _vk_presentation_queue; }
+        const VkQueue& get_vk_transfer_queue() const { return _vk_transfer_queue; }
+        const queue_families_indices& get_queue_families_indices() const { return _queue_families_indices; }
+        bool is_timeline_semaphore_enabled() const { return _is_timeline_semaphore_enabled; }
+        bool is_descriptor_indexing_enabled() const { return _is_descriptor_indexing_enabled; }
+        const VkAllocationCallbacks* get_allocation_callbacks(host_object_type type) const { return _host_allocator->get_callbacks(type); }
 
         void wait_idle();
-        void submit_to_graphics_queue(const command_buffers& command_buffers);
 
     private:
+        std::shared_ptr<host_allocator> _host_allocator;
         VkQueue _vk_graphics_queue;
         VkQueue _vk_presentation_queue;
+        VkQueue _vk_transfer_queue;
+        queue_families_indices _queue_families_indices;
+        bool _is_timeline_semaphore_enabled;
+        bool _is_descriptor_indexing_enabled;
     };
 } // namespace owl::vulkan
\ No newline at end of file
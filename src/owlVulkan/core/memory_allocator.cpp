@@ -0,0 +1,279 @@
+#include "memory_allocator.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace owl::vulkan::core
+{
+    memory_block::memory_block(const std::shared_ptr<logical_device>& logical_device,
+                               uint32_t memory_type_index,
+                               VkDeviceSize size,
+                               VkMemoryPropertyFlags property_flags,
+                               resource_tiling tiling,
+                               bool is_dedicated)
+        : _device_memory(logical_device, memory_type_index, size)
+        , _ranges(size)
+        , _property_flags(property_flags)
+        , _tiling(tiling)
+        , _is_dedicated(is_dedicated)
+    {
+        if (_property_flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+            _mapped_data = _device_memory.map();
+    }
+
+    memory_block::~memory_block()
+    {
+        if (_mapped_data != nullptr)
+            _device_memory.unmap();
+    }
+
+    void* memory_allocation::get_mapped_data() const
+    {
+        void* block_data = block->get_mapped_data();
+        return block_data != nullptr ? static_cast<char*>(block_data) + offset : nullptr;
+    }
+
+    memory_allocator::memory_allocator(const std::shared_ptr<physical_device>& physical_device,
+                                       const std::shared_ptr<logical_device>& logical_device,
+                                       const std::shared_ptr<memory_tracker>& memory_tracker,
+                                       VkDeviceSize block_size)
+        : _physical_device(physical_device)
+        , _logical_device(logical_device)
+        , _memory_tracker(memory_tracker)
+        , _block_size(block_size)
+    {
+        vkGetPhysicalDeviceMemoryProperties(_physical_device->get_vk_handle(), &_memory_properties);
+        _buffer_image_granularity = _physical_device->get_properties().limits.bufferImageGranularity;
+        _is_unified_memory = detect_unified_memory();
+    }
+
+    memory_allocator::~memory_allocator() { _blocks.clear(); }
+
+    memory_allocation memory_allocator::allocate(const VkMemoryRequirements& memory_requirements,
+                                                 VkMemoryPropertyFlags properties,
+                                                 resource_tiling tiling,
+                                                 memory_category category,
+                                                 VkMemoryPropertyFlags preferred_properties)
+    {
+        uint32_t memory_type_index =
+            device_memory::find_memory_type(_physical_device, memory_requirements.memoryTypeBits, properties, preferred_properties);
+        resource_tiling block_tiling = get_block_tiling(tiling);
+        VkDeviceSize block_size = get_block_size(memory_type_index);
+
+        memory_allocation allocation{};
+        allocation.size = memory_requirements.size;
+        allocation.category = category;
+
+        auto property_flags = _memory_properties.memoryTypes[memory_type_index].propertyFlags;
+        bool is_lazily_allocated = property_flags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+
+        // lazily allocated memory is only committed on use, sharing a block would defeat that
+        if (is_lazily_allocated || memory_requirements.size > block_size / 2)
+        {
+            allocation.block = &create_block(memory_type_index, memory_requirements.size, block_tiling, true);
+            allocation.offset = allocation.block->get_ranges().allocate(memory_requirements.size, 1).value();
+        }
+        else
+        {
+            for (auto& block : _blocks)
+            {
+                if (block->is_dedicated() || block->get_memory_type_index() != memory_type_index || block->get_tiling() != block_tiling)
+                    continue;
+
+                auto offset = block->get_ranges().allocate(memory_requirements.size, memory_requirements.alignment);
+                if (offset.has_value())
+                {
+                    allocation.block = block.get();
+                    allocation.offset = offset.value();
+                    break;
+                }
+            }
+
+            if (allocation.block == nullptr)
+            {
+                auto& block = create_block(memory_type_index, block_size, block_tiling, false);
+                allocation.offset = block.get_ranges().allocate(memory_requirements.size, memory_requirements.alignment).value();
+                allocation.block = &block;
+            }
+        }
+
+        // only counted once backed, a failed vkAllocateMemory throws from create_block before reaching this point
+        _memory_tracker->track_allocation(category, allocation.size);
+
+        return allocation;
+    }
+
+    std::optional<memory_allocation> memory_allocator::reallocate(const memory_allocation& allocation,
+                                                                  const VkMemoryRequirements& memory_requirements)
+    {
+        const memory_block* source_block = allocation.block;
+        if (source_block == nullptr || source_block->is_dedicated())
+            return std::nullopt;
+
+        // pack into the fullest compatible block so the emptiest ones drain first; the kept empty block is never a destination,
+        // moving into it would only turn the source into the next empty block
+        std::vector<memory_block*> candidate_blocks;
+        for (auto& block : _blocks)
+        {
+            if (block.get() != source_block && !block->get_ranges().is_empty() && are_blocks_compatible(*block, *source_block) &&
+                (memory_requirements.memoryTypeBits & (1 << block->get_memory_type_index())))
+                candidate_blocks.push_back(block.get());
+        }
+
+        std::sort(candidate_blocks.begin(), candidate_blocks.end(), [](const memory_block* left, const memory_block* right) {
+            return left->get_ranges().get_used_size() > right->get_ranges().get_used_size();
+        });
+
+        for (auto block : candidate_blocks)
+        {
+            auto offset = block->get_ranges().allocate(memory_requirements.size, memory_requirements.alignment);
+            if (!offset.has_value())
+                continue;
+
+            memory_allocation new_allocation{};
+            new_allocation.block = block;
+            new_allocation.offset = offset.value();
+            new_allocation.size = memory_requirements.size;
+            new_allocation.category = allocation.category;
+            _memory_tracker->track_allocation(new_allocation.category, new_allocation.size);
+
+            return new_allocation;
+        }
+
+        return std::nullopt;
+    }
+
+    void memory_allocator::free(const memory_allocation& allocation)
+    {
+        if (allocation.block == nullptr)
+            return;
+
+        allocation.block->get_ranges().free(allocation.offset);
+        _memory_tracker->track_free(allocation.category, allocation.size);
+
+        if (allocation.block->get_ranges().is_empty())
+            release_block(allocation.block);
+    }
+
+    const memory_block* memory_allocator::find_defragmentation_source() const
+    {
+        const memory_block* source_block = nullptr;
+
+        for (const auto& block : _blocks)
+        {
+            const auto& ranges = block->get_ranges();
+            if (block->is_dedicated() || ranges.is_empty())
+                continue;
+
+            // only the free space of blocks in use counts, so a source is only chosen when its whole content fits elsewhere
+            // and the block can be released once drained
+            VkDeviceSize compatible_free_size = 0;
+            for (const auto& other : _blocks)
+            {
+                const auto& other_ranges = other->get_ranges();
+                if (other != block && !other_ranges.is_empty() && are_blocks_compatible(*other, *block))
+                    compatible_free_size += other_ranges.get_size() - other_ranges.get_used_size();
+            }
+
+            if (compatible_free_size < ranges.get_used_size())
+                continue;
+
+            if (source_block == nullptr || ranges.get_used_size() < source_block->get_ranges().get_used_size())
+                source_block = block.get();
+        }
+
+        return source_block;
+    }
+
+    memory_statistics memory_allocator::get_statistics() const
+    {
+        memory_statistics statistics{};
+        statistics.blocks_count = _blocks.size();
+        statistics.device_allocations_count = _device_allocations_count;
+
+        VkDeviceSize largest_free_ranges_size = 0;
+        for (const auto& block : _blocks)
+        {
+            const auto& ranges = block->get_ranges();
+            VkDeviceSize largest_free_range = ranges.get_largest_free_range();
+
+            statistics.allocations_count += ranges.get_allocations_count();
+            statistics.reserved_size += ranges.get_size();
+            statistics.used_size += ranges.get_used_size();
+            statistics.largest_free_range = std::max(statistics.largest_free_range, largest_free_range);
+            largest_free_ranges_size += largest_free_range;
+        }
+
+        statistics.free_size = statistics.reserved_size - statistics.used_size;
+        if (statistics.free_size > 0)
+            statistics.fragmentation = 1.0f - static_cast<float>(largest_free_ranges_size) / static_cast<float>(statistics.free_size);
+
+        return statistics;
+    }
+
+    bool memory_allocator::detect_unified_memory() const
+    {
+        auto device_type = _physical_device->get_properties().deviceType;
+        if (device_type != VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU && device_type != VK_PHYSICAL_DEVICE_TYPE_CPU)
+            return false;
+
+        VkMemoryPropertyFlags unified_flags =
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        for (uint32_t i = 0; i < _memory_properties.memoryTypeCount; ++i)
+        {
+            if ((_memory_properties.memoryTypes[i].propertyFlags & unified_flags) == unified_flags)
+                return true;
+        }
+
+        return false;
+    }
+
+    VkDeviceSize memory_allocator::get_block_size(uint32_t memory_type_index) const
+    {
+        uint32_t heap_index = _memory_properties.memoryTypes[memory_type_index].heapIndex;
+        return std::min(_block_size, _memory_properties.memoryHeaps[heap_index].size / 8);
+    }
+
+    bool memory_allocator::are_blocks_compatible(const memory_block& block, const memory_block& other)
+    {
+        return !block.is_dedicated() && !other.is_dedicated() && block.get_memory_type_index() == other.get_memory_type_index() &&
+               block.get_tiling() == other.get_tiling();
+    }
+
+    resource_tiling memory_allocator::get_block_tiling(resource_tiling tiling) const
+    {
+        // linear and optimal resources only need to live in separate blocks when the device enforces a granularity between them
+        return _buffer_image_granularity > 1 ? tiling : resource_tiling::linear;
+    }
+
+    memory_block& memory_allocator::create_block(uint32_t memory_type_index, VkDeviceSize size, resource_tiling tiling, bool is_dedicated)
+    {
+        auto property_flags = _memory_properties.memoryTypes[memory_type_index].propertyFlags;
+
+        _blocks.push_back(std::make_unique<memory_block>(_logical_device, memory_type_index, size, property_flags, tiling, is_dedicated));
+        ++_device_allocations_count;
+        _memory_tracker->track_device_allocation(_memory_properties.memoryTypes[memory_type_index].heapIndex, size);
+
+        return *_blocks.back();
+    }
+
+    void memory_allocator::release_block(memory_block* block)
+    {
+        if (!block->is_dedicated())
+        {
+            // keep one empty block per memory type around so that load/unload cycles do not churn device allocations
+            auto empty_blocks_count = std::count_if(_blocks.begin(), _blocks.end(), [block](const auto& other) {
+                return !other->is_dedicated() && other->get_memory_type_index() == block->get_memory_type_index() &&
+                       other->get_tiling() == block->get_tiling() && other->get_ranges().is_empty();
+            });
+
+            if (empty_blocks_count <= 1)
+                return;
+        }
+
+        uint32_t heap_index = _memory_properties.memoryTypes[block->get_memory_type_index()].heapIndex;
+        _memory_tracker->track_device_free(heap_index, block->get_ranges().get_size());
+
+        _blocks.erase(std::find_if(_blocks.begin(), _blocks.end(), [block](const auto& other) { return other.get() == block; }));
+    }
+} // namespace owl::vulkan::core
\ No newline at end of file
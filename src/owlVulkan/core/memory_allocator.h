@@ -0,0 +1,122 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "device_memory.h"
+#include "logical_device.h"
+#include "memory_tracker.h"
+#include "physical_device.h"
+#include "range_allocator.h"
+
+namespace owl::vulkan::core
+{
+    enum class resource_tiling
+    {
+        linear,
+        optimal
+    };
+
+    class memory_block
+    {
+    public:
+        memory_block(const std::shared_ptr<logical_device>& logical_device,
+                     uint32_t memory_type_index,
+                     VkDeviceSize size,
+                     VkMemoryPropertyFlags property_flags,
+                     resource_tiling tiling,
+                     bool is_dedicated);
+        ~memory_block();
+
+        const VkDeviceMemory& get_vk_device_memory() const { return _device_memory.get_vk_handle(); }
+        uint32_t get_memory_type_index() const { return _device_memory.get_memory_type_index(); }
+        VkMemoryPropertyFlags get_property_flags() const { return _property_flags; }
+        resource_tiling get_tiling() const { return _tiling; }
+        bool is_dedicated() const { return _is_dedicated; }
+        void* get_mapped_data() const { return _mapped_data; }
+
+        range_allocator& get_ranges() { return _ranges; }
+        const range_allocator& get_ranges() const { return _ranges; }
+
+    private:
+        device_memory _device_memory;
+        range_allocator _ranges;
+        VkMemoryPropertyFlags _property_flags;
+        resource_tiling _tiling;
+        bool _is_dedicated;
+        void* _mapped_data = nullptr;
+    };
+
+    struct memory_allocation
+    {
+        memory_block* block = nullptr;
+        VkDeviceSize offset = 0;
+        VkDeviceSize size = 0;
+        memory_category category = memory_category::other;
+
+        const VkDeviceMemory& get_vk_device_memory() const { return block->get_vk_device_memory(); }
+        VkMemoryPropertyFlags get_property_flags() const { return block->get_property_flags(); }
+        void* get_mapped_data() const;
+    };
+
+    struct memory_statistics
+    {
+        size_t blocks_count = 0;
+        size_t allocations_count = 0;
+        size_t device_allocations_count = 0;
+        VkDeviceSize reserved_size = 0;
+        VkDeviceSize used_size = 0;
+        VkDeviceSize free_size = 0;
+        VkDeviceSize largest_free_range = 0;
+        float fragmentation = 0.0f;
+    };
+
+    class memory_allocator
+    {
+    public:
+        static constexpr VkDeviceSize default_block_size = 64 * 1024 * 1024;
+
+        memory_allocator(const std::shared_ptr<physical_device>& physical_device,
+                         const std::shared_ptr<logical_device>& logical_device,
+                         const std::shared_ptr<memory_tracker>& memory_tracker,
+                         VkDeviceSize block_size = default_block_size);
+        ~memory_allocator();
+
+        const std::shared_ptr<physical_device>& get_physical_device() const { return _physical_device; }
+        const std::shared_ptr<memory_tracker>& get_memory_tracker() const { return _memory_tracker; }
+        bool is_unified_memory() const { return _is_unified_memory; }
+
+        memory_allocation allocate(const VkMemoryRequirements& memory_requirements,
+                                   VkMemoryPropertyFlags properties,
+                                   resource_tiling tiling,
+                                   memory_category category,
+                                   VkMemoryPropertyFlags preferred_properties = 0);
+        std::optional<memory_allocation> reallocate(const memory_allocation& allocation, const VkMemoryRequirements& memory_requirements);
+        void free(const memory_allocation& allocation);
+
+        const memory_block* find_defragmentation_source() const;
+        memory_statistics get_statistics() const;
+
+    private:
+        std::shared_ptr<physical_device> _physical_device;
+        std::shared_ptr<logical_device> _logical_device;
+        std::shared_ptr<memory_tracker> _memory_tracker;
+        VkPhysicalDeviceMemoryProperties _memory_properties;
+        VkDeviceSize _buffer_image_granularity;
+        VkDeviceSize _block_size;
+        size_t _device_allocations_count = 0;
+        bool _is_unified_memory = false;
+
+        std::vector<std::unique_ptr<memory_block>> _blocks;
+
+        bool detect_unified_memory() const;
+        VkDeviceSize get_block_size(uint32_t memory_type_index) const;
+        resource_tiling get_block_tiling(resource_tiling tiling) const;
+        static bool are_blocks_compatible(const memory_block& block, const memory_block& other);
+        memory_block& create_block(uint32_t memory_type_index, VkDeviceSize size, resource_tiling tiling, bool is_dedicated);
+        void release_block(memory_block* block);
+    };
+} // namespace owl::vulkan::core
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include "memory_tracker.h"
+
+#include <sstream>
+
+namespace owl::vulkan::core
+{
+    const char* to_string(memory_category category)
+    {
+        switch (category)
+        {
+        case memory_category::mesh:
+            return "mesh";
+        case memory_category::texture:
+            return "texture";
+        case memory_category::attachment:
+            return "attachment";
+        case memory_category::staging:
+            return "staging";
+        case memory_category::uniform:
+            return "uniform";
+        default:
+            return "other";
+        }
+    }
+
+    std::string memory_report::to_json() const
+    {
+        std::ostringstream json;
+        json << "{\"is_budget_reported\":" << (is_budget_reported ? "true" : "false") << ",\"heaps\":[";
+
+        for (size_t i = 0; i < heaps.size(); ++i)
+        {
+            const auto& heap = heaps[i];
+            json << (i > 0 ? "," : "") << "{\"index\":" << i << ",\"size\":" << heap.size
+                 << ",\"is_device_local\":" << (heap.is_device_local ? "true" : "false")
+                 << ",\"device_allocations_count\":" << heap.device_allocations_count << ",\"allocated_size\":" << heap.allocated_size
+                 << ",\"budget\":" << heap.budget << ",\"usage\":" << heap.usage << "}";
+        }
+
+        json << "],\"categories\":{";
+
+        for (size_t i = 0; i < categories.size(); ++i)
+        {
+            json << (i > 0 ? "," : "") << "\"" << to_string(static_cast<memory_category>(i))
+                 << "\":{\"allocations_count\":" << categories[i].allocations_count << ",\"size\":" << categories[i].size << "}";
+        }
+
+        json << "}}";
+
+        return json.str();
+    }
+
+    memory_tracker::memory_tracker(const std::shared_ptr<instance>& instance,
+                                   const std::shared_ptr<physical_device>& physical_device,
+                                   bool is_memory_budget_enabled)
+        : _physical_device(physical_device)
+    {
+        vkGetPhysicalDeviceMemoryProperties(_physical_device->get_vk_handle(), &_memory_properties);
+
+        if (is_memory_budget_enabled)
+            _get_memory_properties2 = (PFN_vkGetPhysicalDeviceMemoryProperties2KHR)vkGetInstanceProcAddr(
+                instance->get_vk_handle(), "vkGetPhysicalDeviceMemoryProperties2KHR");
+
+        _heaps.resize(_memory_properties.memoryHeapCount);
+        for (uint32_t i = 0; i < _memory_properties.memoryHeapCount; ++i)
+        {
+            _heaps[i].size = _memory_properties.memoryHeaps[i].size;
+            _heaps[i].is_device_local = _memory_properties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+        }
+    }
+
+    void memory_tracker::track_device_allocation(uint32_t heap_index, VkDeviceSize size)
+    {
+        ++_heaps[heap_index].device_allocations_count;
+        _heaps[heap_index].allocated_size += size;
+    }
+
+    void memory_tracker::track_device_free(uint32_t heap_index, VkDeviceSize size)
+    {
+        --_heaps[heap_index].device_allocations_count;
+        _heaps[heap_index].allocated_size -= size;
+    }
+
+    void memory_tracker::track_allocation(memory_category category, VkDeviceSize size)
+    {
+        auto& usage = _categories[static_cast<size_t>(category)];
+        ++usage.allocations_count;
+        usage.size += size;
+    }
+
+    void memory_tracker::track_free(memory_category category, VkDeviceSize size)
+    {
+        auto& usage = _categories[static_cast<size_t>(category)];
+        --usage.allocations_count;
+        usage.size -= size;
+    }
+
+    memory_report memory_tracker::get_report() const
+    {
+        memory_report report{};
+        report.heaps = _heaps;
+        report.categories = _categories;
+
+        if (_get_memory_properties2 != nullptr)
+        {
+            VkPhysicalDeviceMemoryBudgetPropertiesEXT budget_properties{};
+            budget_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+            VkPhysicalDeviceMemoryProperties2 memory_properties{};
+            memory_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+            memory_properties.pNext = &budget_properties;
+
+            _get_memory_properties2(_physical_device->get_vk_handle(), &memory_properties);
+
+            report.is_budget_reported = true;
+            for (size_t i = 0; i < report.heaps.size(); ++i)
+            {
+                report.heaps[i].budget = budget_properties.heapBudget[i];
+                report.heaps[i].usage = budget_properties.heapUsage[i];
+            }
+        }
+        else
+        {
+            // without VK_EXT_memory_budget only our own allocations are known, and the heap size is the only limit
+            for (auto& heap : report.heaps)
+            {
+                heap.budget = heap.size;
+                heap.usage = heap.allocated_size;
+            }
+        }
+
+        return report;
+    }
+} // namespace owl::vulkan::core
\ No newline at end of file
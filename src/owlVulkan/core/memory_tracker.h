@@ -0,0 +1,75 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "instance.h"
+#include "physical_device.h"
+
+namespace owl::vulkan::core
+{
+    enum class memory_category
+    {
+        mesh,
+        texture,
+        attachment,
+        staging,
+        uniform,
+        other,
+        count
+    };
+
+    const char* to_string(memory_category category);
+
+    struct memory_category_usage
+    {
+        size_t allocations_count = 0;
+        VkDeviceSize size = 0;
+    };
+
+    struct memory_heap_usage
+    {
+        VkDeviceSize size = 0;
+        bool is_device_local = false;
+        size_t device_allocations_count = 0;
+        VkDeviceSize allocated_size = 0;
+        VkDeviceSize budget = 0;
+        VkDeviceSize usage = 0;
+    };
+
+    struct memory_report
+    {
+        bool is_budget_reported = false;
+        std::vector<memory_heap_usage> heaps;
+        std::array<memory_category_usage, static_cast<size_t>(memory_category::count)> categories{};
+
+        std::string to_json() const;
+    };
+
+    class memory_tracker
+    {
+    public:
+        memory_tracker(const std::shared_ptr<instance>& instance,
+                       const std::shared_ptr<physical_device>& physical_device,
+                       bool is_memory_budget_enabled);
+
+        void track_device_allocation(uint32_t heap_index, VkDeviceSize size);
+        void track_device_free(uint32_t heap_index, VkDeviceSize size);
+        void track_allocation(memory_category category, VkDeviceSize size);
+        void track_free(memory_category category, VkDeviceSize size);
+
+        memory_report get_report() const;
+
+    private:
+        std::shared_ptr<physical_device> _physical_device;
+        PFN_vkGetPhysicalDeviceMemoryProperties2KHR _get_memory_properties2 = nullptr;
+        VkPhysicalDeviceMemoryProperties _memory_properties;
+
+        std::vector<memory_heap_usage> _heaps;
+        std::array<memory_category_usage, static_cast<size_t>(memory_category::count)> _categories{};
+    };
+} // namespace owl::vulkan::core
\ No newline at end of file
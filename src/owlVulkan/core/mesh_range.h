@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+#include "resource_pool.h"
+
+namespace owl::vulkan::core
+{
+    struct mesh_range
+    {
+        uint32_t first_index = 0;
+        uint32_t index_count = 0;
+        int32_t vertex_offset = 0;
+        uint32_t vertex_count = 0;
+    };
+
+    using mesh_handle = resource_handle<mesh_range>;
+} // namespace owl::vulkan::core
\ No newline at end of file
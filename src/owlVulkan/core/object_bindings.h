@@ -0,0 +1,13 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+namespace owl::vulkan::core
+{
+    // the resources one draw binds, laid out in binding order so an update template reads a whole set straight from it
+    struct object_bindings
+    {
+        VkDescriptorBufferInfo uniform_buffer{};
+        VkDescriptorImageInfo texture{};
+    };
+} // namespace owl::vulkan::core
\ No newline at end of file
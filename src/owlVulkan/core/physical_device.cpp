@@ -32,6 +32,7 @@ namespace owl::vulkan::core
         if (_vk_handle == VK_NULL_HANDLE)
             throw std::runtime_error("No suitable device found.");
 
+        vkGetPhysicalDeviceProperties(_vk_handle, &_properties);
         _max_usable_samples = compute_max_usable_sample_count();
     }
 
@@ -58,7 +59,7 @@ namespace owl::vulkan::core
     bool physical_device::check_device_extension_support(const VkPhysicalDevice& device,
                                                          const std::vector<const char*>& required_device_extensions)
     {
-        std::vector<VkExtensionProperties> available_extensions = get_extension_properties(device);
+        auto available_extensions = get_extension_properties(device);
         std::set<std::string> required_extensions(required_device_extensions.begin(), required_device_extensions.end());
 
         for (const auto& extension : available_extensions)
@@ -67,6 +68,76 @@ namespace owl::vulkan::core
         return required_extensions.empty();
     }
 
+    bool physical_device::supports_extension(const char* extension_name)
+    {
+        return check_device_extension_support(_vk_handle, {extension_name});
+    }
+
+    bool physical_device::supports_timeline_semaphores() const
+    {
+        if (_instance->get_api_version() < VK_API_VERSION_1_2 || _properties.apiVersion < VK_API_VERSION_1_2)
+            return false;
+
+        auto get_features2 =
+            (PFN_vkGetPhysicalDeviceFeatures2KHR)vkGetInstanceProcAddr(_instance->get_vk_handle(), "vkGetPhysicalDeviceFeatures2");
+        if (get_features2 == nullptr)
+            return false;
+
+        VkPhysicalDeviceTimelineSemaphoreFeatures timeline_features{};
+        timeline_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+
+        VkPhysicalDeviceFeatures2 features{};
+        features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features.pNext = &timeline_features;
+        get_features2(_vk_handle, &features);
+
+        return timeline_features.timelineSemaphore == VK_TRUE;
+    }
+
+    bool physical_device::supports_descriptor_indexing() const
+    {
+        // descriptor indexing is core since vulkan 1.2, like timeline semaphores
+        if (_instance->get_api_version() < VK_API_VERSION_1_2 || _properties.apiVersion < VK_API_VERSION_1_2)
+            return false;
+
+        auto get_features2 =
+            (PFN_vkGetPhysicalDeviceFeatures2KHR)vkGetInstanceProcAddr(_instance->get_vk_handle(), "vkGetPhysicalDeviceFeatures2");
+        if (get_features2 == nullptr)
+            return false;
+
+        VkPhysicalDeviceDescriptorIndexingFeatures indexing_features{};
+        indexing_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+
+        VkPhysicalDeviceFeatures2 features{};
+        features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features.pNext = &indexing_features;
+        get_features2(_vk_handle, &features);
+
+        return features.features.shaderSampledImageArrayDynamicIndexing == VK_TRUE && indexing_features.runtimeDescriptorArray == VK_TRUE &&
+               indexing_features.descriptorBindingPartiallyBound == VK_TRUE &&
+               indexing_features.descriptorBindingSampledImageUpdateAfterBind == VK_TRUE &&
+               indexing_features.descriptorBindingStorageBufferUpdateAfterBind == VK_TRUE &&
+               indexing_features.descriptorBindingUpdateUnusedWhilePending == VK_TRUE;
+    }
+
+    VkPhysicalDeviceDescriptorIndexingProperties physical_device::get_descriptor_indexing_properties() const
+    {
+        VkPhysicalDeviceDescriptorIndexingProperties indexing_properties{};
+        indexing_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+
+        auto get_properties2 =
+            (PFN_vkGetPhysicalDeviceProperties2KHR)vkGetInstanceProcAddr(_instance->get_vk_handle(), "vkGetPhysicalDeviceProperties2");
+        if (get_properties2 == nullptr)
+            return indexing_properties;
+
+        VkPhysicalDeviceProperties2 properties{};
+        properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties.pNext = &indexing_properties;
+        get_properties2(_vk_handle, &properties);
+
+        return indexing_properties;
+    }
+
     bool physical_device::supports_linear_filtering(VkFormat format)
     {
         VkFormatProperties format_properties;
@@ -116,12 +187,14 @@ namespace owl::vulkan::core
         return details;
     }
 
-    std::vector<VkExtensionProperties> physical_device::get_extension_properties(const VkPhysicalDevice& device, const char* layer_name)
+    std::pmr::vector<VkExtensionProperties> physical_device::get_extension_properties(const VkPhysicalDevice& device,
+                                                                                       const char* layer_name,
+                                                                                       std::pmr::memory_resource* memory_resource)
     {
         auto enumerateExtensionProperties = vkEnumerateDeviceExtensionProperties;
         auto function = std::bind(enumerateExtensionProperties, device, layer_name, std::placeholders::_1, std::placeholders::_2);
 
-        return helpers::getElements<VkExtensionProperties>(function);
+        return helpers::getElements<VkExtensionProperties>(function, memory_resource);
     }
 
     std::vector<VkSurfaceFormatKHR> physical_device::get_surface_formats(const VkPhysicalDevice& device)
@@ -177,16 +250,35 @@ namespace owl::vulkan::core
             i++;
         }
 
+        find_transfer_family(indices, queue_families);
+
         return indices;
     }
 
-    VkSampleCountFlagBits physical_device::compute_max_usable_sample_count()
+    void physical_device::find_transfer_family(queue_families_indices& indices, const std::vector<VkQueueFamilyProperties>& queue_families)
     {
-        VkPhysicalDeviceProperties physical_device_properties;
-        vkGetPhysicalDeviceProperties(_vk_handle, &physical_device_properties);
+        if (!indices.graphics_family.has_value())
+            return;
 
-        VkSampleCountFlags counts =
-            physical_device_properties.limits.framebufferColorSampleCounts & physical_device_properties.limits.framebufferDepthSampleCounts;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(queue_families.size()); ++i)
+        {
+            auto queue_flags = queue_families[i].queueFlags;
+            if ((queue_flags & VK_QUEUE_TRANSFER_BIT) && !(queue_flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)))
+            {
+                indices.transfer_family = i;
+                indices.transfer_queue_index = 0;
+                return;
+            }
+        }
+
+        // no transfer only family, use a second queue of the graphics family if there is one, otherwise share the graphics queue
+        indices.transfer_family = indices.graphics_family;
+        indices.transfer_queue_index = queue_families[indices.graphics_family.value()].queueCount > 1 ? 1 : 0;
+    }
+
+    VkSampleCountFlagBits physical_device::compute_max_usable_sample_count()
+    {
+        VkSampleCountFlags counts = _properties.limits.framebufferColorSampleCounts & _properties.limits.framebufferDepthSampleCounts;
         if (counts & VK_SAMPLE_COUNT_64_BIT)
             return VK_SAMPLE_COUNT_64_BIT;
         if (counts & VK_SAMPLE_COUNT_32_BIT)
@@ -3,6 +3,7 @@
 #include <vulkan/vulkan.h>
 
 #include <memory>
+#include <memory_resource>
 
 #include "instance.h"
 #include "queue_families_indices.h"
@@ -21,21 +22,32 @@ namespace owl::vulkan::core
         ~physical_device();
 
         bool supports_linear_filtering(VkFormat format);
+        bool supports_extension(const char* extension_name);
+        bool supports_timeline_semaphores() const;
+        // runtime sized, partially bound arrays of sampled images and storage buffers that can be written after being bound
+        bool supports_descriptor_indexing() const;
+        VkPhysicalDeviceDescriptorIndexingProperties get_descriptor_indexing_properties() const;
         VkFormat get_depth_format();
         queue_families_indices find_queue_families();
         swapchain_support query_swapchain_support();
         VkSampleCountFlagBits get_max_usable_sample_count() const { return _max_usable_samples; };
+        const VkPhysicalDeviceProperties& get_properties() const { return _properties; }
 
     private:
         std::shared_ptr<instance> _instance;
         std::shared_ptr<surface> _surface;
+        VkPhysicalDeviceProperties _properties{};
         VkSampleCountFlagBits _max_usable_samples = VK_SAMPLE_COUNT_1_BIT;
 
         bool is_device_suitable(const VkPhysicalDevice& device, const std::vector<const char*>& required_device_extensions);
         bool check_device_extension_support(const VkPhysicalDevice& device, const std::vector<const char*>& required_device_extensions);
         queue_families_indices find_queue_families(const VkPhysicalDevice& device);
+        void find_transfer_family(queue_families_indices& indices, const std::vector<VkQueueFamilyProperties>& queue_families);
         VkFormat get_supported_format(const std::vector<VkFormat>& candidates, VkImageTiling tiling, VkFormatFeatureFlags features);
-        std::vector<VkExtensionProperties> get_extension_properties(const VkPhysicalDevice& device, const char* layer_name = nullptr);
+        std::pmr::vector<VkExtensionProperties> get_extension_properties(
+            const VkPhysicalDevice& device,
+            const char* layer_name = nullptr,
+            std::pmr::memory_resource* memory_resource = std::pmr::get_default_resource());
         std::vector<VkSurfaceFormatKHR> get_surface_formats(const VkPhysicalDevice& device);
         std::vector<VkPresentModeKHR> get_surface_present_modes(const VkPhysicalDevice& device);
         swapchain_support query_swapchain_support(const VkPhysicalDevice& device);
@@ -5,19 +5,33 @@
 namespace owl::vulkan::core
 {
     pipeline_layout::pipeline_layout(const std::shared_ptr<logical_device>& logical_device,
-                                     const std::shared_ptr<descriptor_set_layout>& descriptor_set_layout)
+                                     const std::shared_ptr<descriptor_set_layout>& descriptor_set_layout,
+                                     const std::vector<VkDescriptorSetLayout>& additional_set_layouts,
+                                     const std::vector<VkPushConstantRange>& push_constant_ranges)
         : _logical_device(logical_device)
     {
+        // the per frame set always comes first, so layouts with and without additional sets stay compatible for set 0
+        std::vector<VkDescriptorSetLayout> set_layouts{descriptor_set_layout->get_vk_handle()};
+        set_layouts.insert(set_layouts.end(), additional_set_layouts.begin(), additional_set_layouts.end());
+
         VkPipelineLayoutCreateInfo pipeline_layout_info{};
         pipeline_layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        pipeline_layout_info.setLayoutCount = 1;
-        pipeline_layout_info.pSetLayouts = &descriptor_set_layout->get_vk_handle();
-        pipeline_layout_info.pushConstantRangeCount = 0;
-        pipeline_layout_info.pPushConstantRanges = nullptr;
+        pipeline_layout_info.setLayoutCount = static_cast<uint32_t>(set_layouts.size());
+        pipeline_layout_info.pSetLayouts = set_layouts.data();
+        pipeline_layout_info.pushConstantRangeCount = static_cast<uint32_t>(push_constant_ranges.size());
+        pipeline_layout_info.pPushConstantRanges = push_constant_ranges.data();
 
-        auto result = vkCreatePipelineLayout(_logical_device->get_vk_handle(), &pipeline_layout_info, nullptr, &_vk_handle);
+        auto result = vkCreatePipelineLayout(_logical_device->get_vk_handle(),
+                                             &pipeline_layout_info,
+                                             _logical_device->get_allocation_callbacks(host_object_type::pipeline_layout),
+                                             &_vk_handle);
         vulkan::helpers::handle_result(result, "Failed to create pipeline layout");
     }
 
-    pipeline_layout::~pipeline_layout() { vkDestroyPipelineLayout(_logical_device->get_vk_handle(), _vk_handle, nullptr); }
+    pipeline_layout::~pipeline_layout()
+    {
+        vkDestroyPipelineLayout(_logical_device->get_vk_handle(),
+                                _vk_handle,
+                                _logical_device->get_allocation_callbacks(host_object_type::pipeline_layout));
+    }
 } // namespace owl::vulkan
\ No newline at end of file
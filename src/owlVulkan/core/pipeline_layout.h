@@ -3,6 +3,7 @@
 #include <vulkan/vulkan.h>
 
 #include <memory>
+#include <vector>
 
 #include "descriptor_set_layout.h"
 #include "logical_device.h"
@@ -14,7 +15,9 @@ namespace owl::vulkan::core
     {
     public:
         pipeline_layout(const std::shared_ptr<logical_device>& logical_device,
-                        const std::shared_ptr<descriptor_set_layout>& descriptor_set_layout);
+                        const std::shared_ptr<descriptor_set_layout>& descriptor_set_layout,
+                        const std::vector<VkDescriptorSetLayout>& additional_set_layouts = {},
+                        const std::vector<VkPushConstantRange>& push_constant_ranges = {});
         ~pipeline_layout();
 
     private:
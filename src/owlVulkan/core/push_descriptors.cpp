@@ -0,0 +1,45 @@
+#include "push_descriptors.h"
+
+#include <stdexcept>
+
+namespace owl::vulkan::core
+{
+    push_descriptors::push_descriptors(const std::shared_ptr<logical_device>& logical_device,
+                                       const std::shared_ptr<descriptor_set_layout>& layout,
+                                       const std::shared_ptr<pipeline_layout>& pipeline_layout,
+                                       bool use_update_template)
+        : _layout(layout)
+        , _pipeline_layout(pipeline_layout)
+    {
+        if (!_layout->is_push_descriptor())
+            throw std::invalid_argument("Descriptors can only be pushed for a push descriptor set layout");
+
+        if (use_update_template)
+        {
+            _update_template = std::make_unique<descriptor_update_template>(logical_device, *_layout, _pipeline_layout->get_vk_handle());
+            return;
+        }
+
+        _push_descriptor_set =
+            (PFN_vkCmdPushDescriptorSetKHR)vkGetDeviceProcAddr(logical_device->get_vk_handle(), "vkCmdPushDescriptorSetKHR");
+        if (_push_descriptor_set == nullptr)
+            throw std::runtime_error("Push descriptors are not supported by the device");
+    }
+
+    void push_descriptors::push(VkCommandBuffer vk_command_buffer, const object_bindings& bindings) const
+    {
+        if (_update_template != nullptr)
+        {
+            _update_template->push(vk_command_buffer, bindings);
+            return;
+        }
+
+        auto descriptor_writes = _layout->create_writes(VK_NULL_HANDLE, bindings);
+        _push_descriptor_set(vk_command_buffer,
+                             VK_PIPELINE_BIND_POINT_GRAPHICS,
+                             _pipeline_layout->get_vk_handle(),
+                             0,
+                             static_cast<uint32_t>(descriptor_writes.size()),
+                             descriptor_writes.data());
+    }
+} // namespace owl::vulkan::core
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <memory>
+
+#include "descriptor_set_layout.h"
+#include "descriptor_update_template.h"
+#include "logical_device.h"
+#include "object_bindings.h"
+#include "pipeline_layout.h"
+
+namespace owl::vulkan::core
+{
+    // binds per draw resources by recording them straight into the command buffer, so no set is allocated or written
+    // beforehand; pushes through an update template when the device has them, and through plain writes otherwise
+    class push_descriptors
+    {
+    public:
+        push_descriptors(const std::shared_ptr<logical_device>& logical_device,
+                         const std::shared_ptr<descriptor_set_layout>& layout,
+                         const std::shared_ptr<pipeline_layout>& pipeline_layout,
+                         bool use_update_template);
+
+        bool is_using_update_template() const { return _update_template != nullptr; }
+
+        void push(VkCommandBuffer vk_command_buffer, const object_bindings& bindings) const;
+
+    private:
+        std::shared_ptr<descriptor_set_layout> _layout;
+        std::shared_ptr<pipeline_layout> _pipeline_layout;
+        std::unique_ptr<descriptor_update_template> _update_template;
+        PFN_vkCmdPushDescriptorSetKHR _push_descriptor_set = nullptr;
+    };
+} // namespace owl::vulkan::core
\ No newline at end of file
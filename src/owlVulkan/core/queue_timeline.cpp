@@ -0,0 +1,198 @@
+#include "queue_timeline.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+#include "../helpers/vulkan_helpers.h"
+
+namespace owl::vulkan::core
+{
+    queue_timeline::queue_timeline(const std::shared_ptr<logical_device>& logical_device, const VkQueue& vk_queue)
+        : _logical_device(logical_device)
+        , _vk_queue(vk_queue)
+    {
+        if (!_logical_device->is_timeline_semaphore_enabled())
+            return;
+
+        _get_semaphore_counter_value =
+            (PFN_vkGetSemaphoreCounterValueKHR)vkGetDeviceProcAddr(_logical_device->get_vk_handle(), "vkGetSemaphoreCounterValue");
+        _wait_semaphores = (PFN_vkWaitSemaphoresKHR)vkGetDeviceProcAddr(_logical_device->get_vk_handle(), "vkWaitSemaphores");
+        if (_get_semaphore_counter_value == nullptr || _wait_semaphores == nullptr)
+            return;
+
+        VkSemaphoreTypeCreateInfo type_info{};
+        type_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        type_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        type_info.initialValue = 0;
+
+        VkSemaphoreCreateInfo semaphore_info{};
+        semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphore_info.pNext = &type_info;
+
+        auto result = vkCreateSemaphore(_logical_device->get_vk_handle(),
+                                        &semaphore_info,
+                                        _logical_device->get_allocation_callbacks(host_object_type::semaphore),
+                                        &_vk_semaphore);
+        vulkan::helpers::handle_result(result, "Failed to create timeline semaphore");
+    }
+
+    queue_timeline::~queue_timeline()
+    {
+        wait(get_submitted_value());
+
+        if (_vk_semaphore != VK_NULL_HANDLE)
+            vkDestroySemaphore(_logical_device->get_vk_handle(),
+                               _vk_semaphore,
+                               _logical_device->get_allocation_callbacks(host_object_type::semaphore));
+    }
+
+    uint64_t queue_timeline::get_submitted_value() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _submitted_value;
+    }
+
+    uint64_t queue_timeline::get_completed_value()
+    {
+        if (is_timeline_semaphore())
+        {
+            uint64_t value = 0;
+            auto result = _get_semaphore_counter_value(_logical_device->get_vk_handle(), _vk_semaphore, &value);
+            vulkan::helpers::handle_result(result, "Failed to get timeline semaphore value");
+            return value;
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        retire_signaled_fences();
+        return _completed_value;
+    }
+
+    bool queue_timeline::is_complete(uint64_t value) { return value == 0 || get_completed_value() >= value; }
+
+    void queue_timeline::wait(uint64_t value)
+    {
+        if (value == 0)
+            return;
+
+        if (is_timeline_semaphore())
+        {
+            VkSemaphoreWaitInfo wait_info{};
+            wait_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+            wait_info.semaphoreCount = 1;
+            wait_info.pSemaphores = &_vk_semaphore;
+            wait_info.pValues = &value;
+
+            auto result = _wait_semaphores(_logical_device->get_vk_handle(), &wait_info, UINT64_MAX);
+            vulkan::helpers::handle_result(result, "Failed to wait for timeline semaphore");
+            return;
+        }
+
+        std::shared_ptr<fence> submission_fence;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            retire_signaled_fences();
+            if (value <= _completed_value)
+                return;
+
+            // submissions complete in order on a queue, so the first one reaching the value is enough
+            auto submission = std::find_if(_pending_submissions.begin(),
+                                           _pending_submissions.end(),
+                                           [value](const pending_submission& submission) { return submission.value >= value; });
+            if (submission == _pending_submissions.end())
+                throw std::invalid_argument("Cannot wait for a value that has not been submitted.");
+
+            submission_fence = submission->submission_fence;
+        }
+
+        // the fence is waited without the lock so other threads can keep submitting
+        submission_fence->wait_for_fence();
+    }
+
+    uint64_t queue_timeline::submit(const VkSubmitInfo& submit_info) { return submit(&submit_info, 1); }
+
+    uint64_t queue_timeline::submit(const VkSubmitInfo* submit_infos, uint32_t submit_infos_count)
+    {
+        if (submit_infos_count == 0)
+            throw std::invalid_argument("A timeline submission needs at least one submit info.");
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        uint64_t value = _submitted_value + 1;
+        if (is_timeline_semaphore())
+            submit_with_semaphore(submit_infos, submit_infos_count, value);
+        else
+            submit_with_fence(submit_infos, submit_infos_count, value);
+
+        _submitted_value = value;
+        return value;
+    }
+
+    void queue_timeline::submit_with_semaphore(const VkSubmitInfo* submit_infos, uint32_t submit_infos_count, uint64_t value)
+    {
+        const VkSubmitInfo& last_info = submit_infos[submit_infos_count - 1];
+        if (last_info.signalSemaphoreCount >= max_signal_semaphores)
+            throw std::invalid_argument("Too many signal semaphores for a timeline submission.");
+
+        // binary semaphores ignore their signal value, the timeline is appended after them; batches in one vkQueueSubmit
+        // start in order, so signaling from the last one is enough to cover the whole call
+        std::array<VkSemaphore, max_signal_semaphores> signal_semaphores{};
+        std::array<uint64_t, max_signal_semaphores> signal_values{};
+        std::copy_n(last_info.pSignalSemaphores, last_info.signalSemaphoreCount, signal_semaphores.begin());
+        signal_semaphores[last_info.signalSemaphoreCount] = _vk_semaphore;
+        signal_values[last_info.signalSemaphoreCount] = value;
+
+        VkTimelineSemaphoreSubmitInfo timeline_info{};
+        timeline_info.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timeline_info.pNext = last_info.pNext;
+        timeline_info.signalSemaphoreValueCount = last_info.signalSemaphoreCount + 1;
+        timeline_info.pSignalSemaphoreValues = signal_values.data();
+
+        _submit_infos.assign(submit_infos, submit_infos + submit_infos_count);
+        VkSubmitInfo& timeline_submit_info = _submit_infos.back();
+        timeline_submit_info.pNext = &timeline_info;
+        timeline_submit_info.signalSemaphoreCount = last_info.signalSemaphoreCount + 1;
+        timeline_submit_info.pSignalSemaphores = signal_semaphores.data();
+
+        auto result = vkQueueSubmit(_vk_queue, submit_infos_count, _submit_infos.data(), VK_NULL_HANDLE);
+        vulkan::helpers::handle_result(result, "Failed to submit command buffers.");
+    }
+
+    void queue_timeline::submit_with_fence(const VkSubmitInfo* submit_infos, uint32_t submit_infos_count, uint64_t value)
+    {
+        retire_signaled_fences();
+
+        std::shared_ptr<fence> submission_fence;
+        if (_free_fences.empty())
+        {
+            submission_fence = std::make_shared<fence>(_logical_device);
+        }
+        else
+        {
+            submission_fence = std::move(_free_fences.back());
+            _free_fences.pop_back();
+        }
+
+        submission_fence->reset();
+
+        auto result = vkQueueSubmit(_vk_queue, submit_infos_count, submit_infos, submission_fence->get_vk_handle());
+        vulkan::helpers::handle_result(result, "Failed to submit command buffers.");
+
+        _pending_submissions.push_back({value, std::move(submission_fence)});
+    }
+
+    void queue_timeline::retire_signaled_fences()
+    {
+        while (!_pending_submissions.empty() && _pending_submissions.front().submission_fence->is_signaled())
+        {
+            auto& submission = _pending_submissions.front();
+            _completed_value = submission.value;
+
+            // a fence still held by a waiting thread is left to it rather than reset under its feet
+            if (submission.submission_fence.use_count() == 1)
+                _free_fences.push_back(std::move(submission.submission_fence));
+
+            _pending_submissions.pop_front();
+        }
+    }
+} // namespace owl::vulkan::core
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "fence.h"
+#include "logical_device.h"
+
+namespace owl::vulkan::core
+{
+    // gives every submission to a queue a monotonically increasing value that cpu threads can wait on; backed by a timeline
+    // semaphore when the device supports it, and by one recycled fence per submission otherwise
+    class queue_timeline
+    {
+    public:
+        static constexpr uint32_t max_signal_semaphores = 8;
+
+        queue_timeline(const std::shared_ptr<logical_device>& logical_device, const VkQueue& vk_queue);
+        ~queue_timeline();
+
+        queue_timeline(const queue_timeline&) = delete;
+        queue_timeline& operator=(const queue_timeline&) = delete;
+
+        bool is_timeline_semaphore() const { return _vk_semaphore != VK_NULL_HANDLE; }
+        const VkSemaphore& get_vk_semaphore() const { return _vk_semaphore; }
+        uint64_t get_submitted_value() const;
+
+        uint64_t get_completed_value();
+        bool is_complete(uint64_t value);
+        void wait(uint64_t value);
+
+        uint64_t submit(const VkSubmitInfo& submit_info);
+        // submits every info in one call, the returned value completes once all of them have executed
+        uint64_t submit(const VkSubmitInfo* submit_infos, uint32_t submit_infos_count);
+
+    private:
+        struct pending_submission
+        {
+            uint64_t value;
+            std::shared_ptr<fence> submission_fence;
+        };
+
+        std::shared_ptr<logical_device> _logical_device;
+        VkQueue _vk_queue;
+        VkSemaphore _vk_semaphore = VK_NULL_HANDLE;
+        PFN_vkGetSemaphoreCounterValueKHR _get_semaphore_counter_value = nullptr;
+        PFN_vkWaitSemaphoresKHR _wait_semaphores = nullptr;
+
+        mutable std::mutex _mutex;
+        uint64_t _submitted_value = 0;
+        uint64_t _completed_value = 0;
+        std::deque<pending_submission> _pending_submissions;
+        std::vector<std::shared_ptr<fence>> _free_fences;
+        std::vector<VkSubmitInfo> _submit_infos;
+
+        void submit_with_semaphore(const VkSubmitInfo* submit_infos, uint32_t submit_infos_count, uint64_t value);
+        void submit_with_fence(const VkSubmitInfo* submit_infos, uint32_t submit_infos_count, uint64_t value);
+        void retire_signaled_fences();
+    };
+} // namespace owl::vulkan::core
\ No newline at end of file
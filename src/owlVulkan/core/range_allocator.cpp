@@ -0,0 +1,90 @@
+#include "range_allocator.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace owl::vulkan::core
+{
+    range_allocator::range_allocator(VkDeviceSize size)
+        : _size(size)
+    {
+        _free_ranges.emplace(0, size);
+    }
+
+    std::optional<VkDeviceSize> range_allocator::allocate(VkDeviceSize size, VkDeviceSize alignment)
+    {
+        for (auto it = _free_ranges.begin(); it != _free_ranges.end(); ++it)
+        {
+            VkDeviceSize range_offset = it->first;
+            VkDeviceSize range_end = it->first + it->second;
+            VkDeviceSize offset = align_up(range_offset, alignment);
+
+            if (offset + size > range_end)
+                continue;
+
+            _free_ranges.erase(it);
+
+            if (offset > range_offset)
+                _free_ranges.emplace(range_offset, offset - range_offset);
+            if (offset + size < range_end)
+                _free_ranges.emplace(offset + size, range_end - offset - size);
+
+            _allocated_ranges.emplace(offset, size);
+            _used_size += size;
+
+            return offset;
+        }
+
+        return std::nullopt;
+    }
+
+    void range_allocator::free(VkDeviceSize offset)
+    {
+        auto allocated_range = _allocated_ranges.find(offset);
+        if (allocated_range == _allocated_ranges.end())
+            throw std::invalid_argument("Range was not allocated by this allocator.");
+
+        VkDeviceSize size = allocated_range->second;
+        _allocated_ranges.erase(allocated_range);
+        _used_size -= size;
+
+        auto next = _free_ranges.lower_bound(offset);
+        if (next != _free_ranges.end() && next->first == offset + size)
+        {
+            size += next->second;
+            next = _free_ranges.erase(next);
+        }
+
+        if (next != _free_ranges.begin())
+        {
+            auto previous = std::prev(next);
+            if (previous->first + previous->second == offset)
+            {
+                previous->second += size;
+                return;
+            }
+        }
+
+        _free_ranges.emplace_hint(next, offset, size);
+    }
+
+    VkDeviceSize range_allocator::get_allocated_size(VkDeviceSize offset) const
+    {
+        auto allocated_range = _allocated_ranges.find(offset);
+        return allocated_range != _allocated_ranges.end() ? allocated_range->second : 0;
+    }
+
+    VkDeviceSize range_allocator::get_largest_free_range() const
+    {
+        VkDeviceSize largest_free_range = 0;
+        for (const auto& [offset, size] : _free_ranges)
+            largest_free_range = std::max(largest_free_range, size);
+
+        return largest_free_range;
+    }
+
+    VkDeviceSize align_up(VkDeviceSize value, VkDeviceSize alignment)
+    {
+        return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+    }
+} // namespace owl::vulkan::core
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <map>
+#include <optional>
+#include <unordered_map>
+
+namespace owl::vulkan::core
+{
+    class range_allocator
+    {
+    public:
+        explicit range_allocator(VkDeviceSize size);
+
+        std::optional<VkDeviceSize> allocate(VkDeviceSize size, VkDeviceSize alignment);
+        void free(VkDeviceSize offset);
+
+        VkDeviceSize get_size() const { return _size; }
+        VkDeviceSize get_used_size() const { return _used_size; }
+        VkDeviceSize get_allocated_size(VkDeviceSize offset) const;
+        VkDeviceSize get_largest_free_range() const;
+        size_t get_free_ranges_count() const { return _free_ranges.size(); }
+        size_t get_allocations_count() const { return _allocated_ranges.size(); }
+        bool is_empty() const { return _allocated_ranges.empty(); }
+
+    private:
+        VkDeviceSize _size;
+        VkDeviceSize _used_size = 0;
+        std::map<VkDeviceSize, VkDeviceSize> _free_ranges;
+        std::unordered_map<VkDeviceSize, VkDeviceSize> _allocated_ranges;
+    };
+
+    VkDeviceSize align_up(VkDeviceSize value, VkDeviceSize alignment);
+} // namespace owl::vulkan::core
\ No newline at end of file
@@ -12,11 +12,14 @@ namespace owl::vulkan::core
                              VkSampleCountFlagBits samples)
         : _logical_device(logical_device)
     {
+        // a multisampled color attachment is only read back through its resolve attachment
+        bool is_color_resolved = samples != VK_SAMPLE_COUNT_1_BIT;
+
         VkAttachmentDescription color_attachment{};
         color_attachment.format = color_format;
         color_attachment.samples = samples;
         color_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-        color_attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        color_attachment.storeOp = is_color_resolved ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE;
         color_attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         color_attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
         color_attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -80,9 +83,17 @@ namespace owl::vulkan::core
         render_pass_info.dependencyCount = 1;
         render_pass_info.pDependencies = &dependency;
 
-        auto result = vkCreateRenderPass(_logical_device->get_vk_handle(), &render_pass_info, nullptr, &_vk_handle);
+        auto result = vkCreateRenderPass(_logical_device->get_vk_handle(),
+                                         &render_pass_info,
+                                         _logical_device->get_allocation_callbacks(host_object_type::render_pass),
+                                         &_vk_handle);
         vulkan::helpers::handle_result(result, "Failed to create render pass");
     }
 
-    render_pass::~render_pass() { vkDestroyRenderPass(_logical_device->get_vk_handle(), _vk_handle, nullptr); }
+    render_pass::~render_pass()
+    {
+        vkDestroyRenderPass(_logical_device->get_vk_handle(),
+                            _vk_handle,
+                            _logical_device->get_allocation_callbacks(host_object_type::render_pass));
+    }
 } // namespace owl::vulkan
\ No newline at end of file
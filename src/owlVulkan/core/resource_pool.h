@@ -0,0 +1,192 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace owl::vulkan::core
+{
+    template <typename TResource>
+    struct resource_handle
+    {
+        uint32_t index = invalid_index;
+        uint32_t generation = 0;
+
+        static constexpr uint32_t invalid_index = UINT32_MAX;
+
+        bool is_null() const { return index == invalid_index; }
+        bool operator==(const resource_handle& other) const { return index == other.index && generation == other.generation; }
+        bool operator!=(const resource_handle& other) const { return !(*this == other); }
+    };
+
+    // resources are constructed in place in fixed size chunks, so they never move and stay contiguous for traversal; a slot's
+    // generation is bumped when its resource is destroyed, which makes stale handles detectable with a single comparison
+    template <typename TResource, size_t ChunkSize = 64>
+    class resource_pool
+    {
+    public:
+        using handle = resource_handle<TResource>;
+
+        resource_pool() = default;
+        ~resource_pool() { clear(); }
+
+        resource_pool(const resource_pool&) = delete;
+        resource_pool& operator=(const resource_pool&) = delete;
+
+        template <typename... TArguments>
+        handle create(TArguments&&... arguments);
+        void destroy(handle handle);
+        void clear();
+
+        bool is_valid(handle handle) const;
+        TResource& get(handle handle);
+        const TResource& get(handle handle) const;
+        TResource* try_get(handle handle);
+
+        template <typename TAction>
+        void for_each(TAction&& action);
+
+        size_t get_size() const { return _size; }
+
+    private:
+        struct chunk
+        {
+            alignas(TResource) std::byte storage[sizeof(TResource) * ChunkSize];
+        };
+
+        struct slot
+        {
+            uint32_t generation = 0;
+            bool is_alive = false;
+        };
+
+        std::vector<std::unique_ptr<chunk>> _chunks;
+        std::vector<slot> _slots;
+        std::vector<uint32_t> _free_indices;
+        size_t _size = 0;
+
+        TResource* get_pointer(uint32_t index) const;
+    };
+
+    /////////////////////////////////////////////////TEMPLATE DEFINITIONS//////////////////////////////////////////////////
+
+    template <typename TResource, size_t ChunkSize>
+    template <typename... TArguments>
+    resource_handle<TResource> resource_pool<TResource, ChunkSize>::create(TArguments&&... arguments)
+    {
+        uint32_t index;
+        if (!_free_indices.empty())
+        {
+            index = _free_indices.back();
+            _free_indices.pop_back();
+        }
+        else
+        {
+            index = static_cast<uint32_t>(_slots.size());
+            if (index % ChunkSize == 0)
+                _chunks.push_back(std::make_unique<chunk>());
+            _slots.emplace_back();
+        }
+
+        try
+        {
+            new (get_pointer(index)) TResource(std::forward<TArguments>(arguments)...);
+        }
+        catch (...)
+        {
+            // the slot stays dead with its generation unchanged, no handle to it was ever handed out
+            _free_indices.push_back(index);
+            throw;
+        }
+
+        auto& slot = _slots[index];
+        slot.is_alive = true;
+        ++_size;
+
+        return {index, slot.generation};
+    }
+
+    template <typename TResource, size_t ChunkSize>
+    void resource_pool<TResource, ChunkSize>::destroy(handle handle)
+    {
+        if (!is_valid(handle))
+            throw std::invalid_argument("Resource handle is stale or was not created by this pool.");
+
+        get_pointer(handle.index)->~TResource();
+
+        auto& slot = _slots[handle.index];
+        slot.is_alive = false;
+        ++slot.generation;
+        --_size;
+
+        _free_indices.push_back(handle.index);
+    }
+
+    template <typename TResource, size_t ChunkSize>
+    void resource_pool<TResource, ChunkSize>::clear()
+    {
+        for (uint32_t i = 0; i < _slots.size(); ++i)
+        {
+            if (!_slots[i].is_alive)
+                continue;
+
+            get_pointer(i)->~TResource();
+            _slots[i].is_alive = false;
+            ++_slots[i].generation;
+            _free_indices.push_back(i);
+        }
+
+        _size = 0;
+    }
+
+    template <typename TResource, size_t ChunkSize>
+    bool resource_pool<TResource, ChunkSize>::is_valid(handle handle) const
+    {
+        return handle.index < _slots.size() && _slots[handle.index].is_alive && _slots[handle.index].generation == handle.generation;
+    }
+
+    template <typename TResource, size_t ChunkSize>
+    TResource& resource_pool<TResource, ChunkSize>::get(handle handle)
+    {
+        if (!is_valid(handle))
+            throw std::invalid_argument("Resource handle is stale or was not created by this pool.");
+
+        return *get_pointer(handle.index);
+    }
+
+    template <typename TResource, size_t ChunkSize>
+    const TResource& resource_pool<TResource, ChunkSize>::get(handle handle) const
+    {
+        if (!is_valid(handle))
+            throw std::invalid_argument("Resource handle is stale or was not created by this pool.");
+
+        return *get_pointer(handle.index);
+    }
+
+    template <typename TResource, size_t ChunkSize>
+    TResource* resource_pool<TResource, ChunkSize>::try_get(handle handle)
+    {
+        return is_valid(handle) ? get_pointer(handle.index) : nullptr;
+    }
+
+    template <typename TResource, size_t ChunkSize>
+    template <typename TAction>
+    void resource_pool<TResource, ChunkSize>::for_each(TAction&& action)
+    {
+        for (uint32_t i = 0; i < _slots.size(); ++i)
+        {
+            if (_slots[i].is_alive)
+                action(handle{i, _slots[i].generation}, *get_pointer(i));
+        }
+    }
+
+    template <typename TResource, size_t ChunkSize>
+    TResource* resource_pool<TResource, ChunkSize>::get_pointer(uint32_t index) const
+    {
+        return std::launder(reinterpret_cast<TResource*>(_chunks[index / ChunkSize]->storage) + index % ChunkSize);
+    }
+} // namespace owl::vulkan::core
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include "ring_buffer.h"
+
+#include <stdexcept>
+
+namespace owl::vulkan::core
+{
+    ring_buffer::ring_buffer(const std::shared_ptr<memory_allocator>& memory_allocator,
+                             const std::shared_ptr<logical_device>& logical_device,
+                             VkBufferUsageFlags usage,
+                             VkDeviceSize alignment,
+                             VkDeviceSize region_size,
+                             uint32_t regions_count)
+        : _alignment(alignment)
+        , _region_size(align_up(region_size, alignment))
+        , _regions_count(regions_count)
+    {
+        _buffer = std::make_unique<buffer>(memory_allocator,
+                                           logical_device,
+                                           memory_category::uniform,
+                                           usage,
+                                           VK_SHARING_MODE_EXCLUSIVE,
+                                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                           _region_size * _regions_count,
+                                           VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    }
+
+    void ring_buffer::begin_region(uint32_t region_index)
+    {
+        _region_begin = get_region_offset(region_index % _regions_count);
+        _region_cursor = _region_begin;
+    }
+
+    ring_buffer_slice ring_buffer::allocate(VkDeviceSize size)
+    {
+        VkDeviceSize offset = align_up(_region_cursor, _alignment);
+        if (offset + size > _region_begin + _region_size)
+            throw std::out_of_range("Ring buffer region is full.");
+
+        _region_cursor = offset + size;
+
+        return {offset, static_cast<char*>(_buffer->get_mapped_data()) + offset};
+    }
+} // namespace owl::vulkan::core
\ No newline at end of file
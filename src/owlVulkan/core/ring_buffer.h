@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstring>
+#include <memory>
+
+#include "buffer.h"
+#include "logical_device.h"
+#include "memory_allocator.h"
+
+namespace owl::vulkan::core
+{
+    struct ring_buffer_slice
+    {
+        VkDeviceSize offset;
+        void* data;
+    };
+
+    class ring_buffer
+    {
+    public:
+        ring_buffer(const std::shared_ptr<memory_allocator>& memory_allocator,
+                    const std::shared_ptr<logical_device>& logical_device,
+                    VkBufferUsageFlags usage,
+                    VkDeviceSize alignment,
+                    VkDeviceSize region_size,
+                    uint32_t regions_count);
+
+        const VkBuffer& get_vk_handle() const { return _buffer->get_vk_handle(); }
+        VkDeviceSize get_region_size() const { return _region_size; }
+        uint32_t get_regions_count() const { return _regions_count; }
+        VkDeviceSize get_region_offset(uint32_t region_index) const { return region_index * _region_size; }
+
+        void begin_region(uint32_t region_index);
+        ring_buffer_slice allocate(VkDeviceSize size);
+
+        template <typename TValue>
+        uint32_t push(const TValue& value);
+
+    private:
+        std::unique_ptr<buffer> _buffer;
+        VkDeviceSize _alignment;
+        VkDeviceSize _region_size;
+        uint32_t _regions_count;
+
+        VkDeviceSize _region_begin = 0;
+        VkDeviceSize _region_cursor = 0;
+    };
+
+    /////////////////////////////////////////////////TEMPLATE DEFINITIONS//////////////////////////////////////////////////
+
+    template <typename TValue>
+    uint32_t ring_buffer::push(const TValue& value)
+    {
+        auto slice = allocate(sizeof(TValue));
+        memcpy(slice.data, &value, sizeof(TValue));
+
+        return static_cast<uint32_t>(slice.offset);
+    }
+} // namespace owl::vulkan::core
\ No newline at end of file
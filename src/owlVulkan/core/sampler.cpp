@@ -25,9 +25,17 @@ namespace owl::vulkan::core
         sampler_info.minLod = 0.0f;
         sampler_info.maxLod = static_cast<uint32_t>(mip_levels);
 
-        auto result = vkCreateSampler(_logical_device->get_vk_handle(), &sampler_info, nullptr, &_vk_handle);
+        auto result = vkCreateSampler(_logical_device->get_vk_handle(),
+                                      &sampler_info,
+                                      _logical_device->get_allocation_callbacks(host_object_type::sampler),
+                                      &_vk_handle);
         helpers::handle_result(result, "Failed to create sampler");
     }
 
-    sampler::~sampler() { vkDestroySampler(_logical_device->get_vk_handle(), _vk_handle, nullptr); }
+    sampler::~sampler()
+    {
+        vkDestroySampler(_logical_device->get_vk_handle(),
+                         _vk_handle,
+                         _logical_device->get_allocation_callbacks(host_object_type::sampler));
+    }
 } // namespace owl::vulkan
\ No newline at end of file
@@ -10,9 +10,17 @@ namespace owl::vulkan::core
         VkSemaphoreCreateInfo semaphore_info{};
         semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-        auto result = vkCreateSemaphore(_logical_device->get_vk_handle(), &semaphore_info, nullptr, &_vk_handle);
+        auto result = vkCreateSemaphore(_logical_device->get_vk_handle(),
+                                        &semaphore_info,
+                                        _logical_device->get_allocation_callbacks(host_object_type::semaphore),
+                                        &_vk_handle);
         vulkan::helpers::handle_result(result, "Failed to create semaphore");
     }
 
-    semaphore::~semaphore() { vkDestroySemaphore(_logical_device->get_vk_handle(), _vk_handle, nullptr); }
+    semaphore::~semaphore()
+    {
+        vkDestroySemaphore(_logical_device->get_vk_handle(),
+                           _vk_handle,
+                           _logical_device->get_allocation_callbacks(host_object_type::semaphore));
+    }
 } // namespace owl::vulkan
\ No newline at end of file
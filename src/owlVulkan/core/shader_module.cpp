@@ -15,12 +15,20 @@ namespace owl::vulkan::core
         create_info.codeSize = shader_code.size();
         create_info.pCode = reinterpret_cast<const uint32_t*>(shader_code.data());
 
-        auto result = vkCreateShaderModule(_logical_device->get_vk_handle(), &create_info, nullptr, &_vk_handle);
+        auto result = vkCreateShaderModule(_logical_device->get_vk_handle(),
+                                           &create_info,
+                                           _logical_device->get_allocation_callbacks(host_object_type::shader_module),
+                                           &_vk_handle);
         if (result != VK_SUCCESS)
         {
             throw std::runtime_error("Failed to create shader module: " + std::to_string(result));
         }
     }
 
-    shader_module::~shader_module() { vkDestroyShaderModule(_logical_device->get_vk_handle(), _vk_handle, nullptr); }
+    shader_module::~shader_module()
+    {
+        vkDestroyShaderModule(_logical_device->get_vk_handle(),
+                              _vk_handle,
+                              _logical_device->get_allocation_callbacks(host_object_type::shader_module));
+    }
 } // namespace owl::vulkan
\ No newline at end of file
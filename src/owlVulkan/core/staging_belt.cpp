@@ -0,0 +1,99 @@
+#include "staging_belt.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace owl::vulkan::core
+{
+    staging_belt::staging_belt(const std::shared_ptr<memory_allocator>& memory_allocator,
+                               const std::shared_ptr<logical_device>& logical_device,
+                               VkDeviceSize budget)
+        : _budget(budget)
+    {
+        _buffer = std::make_unique<buffer>(memory_allocator,
+                                           logical_device,
+                                           memory_category::staging,
+                                           VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                           VK_SHARING_MODE_EXCLUSIVE,
+                                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                           _budget);
+    }
+
+    staging_belt::~staging_belt()
+    {
+        while (!_batches.empty())
+        {
+            _batches.front().token.wait();
+            release_front_batch();
+        }
+    }
+
+    staging_region staging_belt::stage(const void* values, VkDeviceSize size, VkDeviceSize alignment)
+    {
+        auto region = try_stage(values, size, alignment);
+        if (!region)
+            throw std::runtime_error("Staging belt budget is exhausted by unsubmitted uploads.");
+
+        return region.value();
+    }
+
+    std::optional<staging_region> staging_belt::try_stage(const void* values, VkDeviceSize size, VkDeviceSize alignment)
+    {
+        if (size > _budget)
+            throw std::length_error("Upload exceeds staging belt budget.");
+
+        reclaim();
+
+        VkDeviceSize offset;
+        VkDeviceSize consumed_size;
+
+        while (true)
+        {
+            if (_used_size == 0)
+                _head = 0;
+
+            offset = align_up(_head, alignment);
+            if (offset + size > _budget)
+                offset = 0;
+
+            consumed_size = offset >= _head ? offset + size - _head : _budget - _head + size;
+            if (_used_size + consumed_size <= _budget)
+                break;
+
+            if (_batches.empty())
+                return std::nullopt;
+
+            _batches.front().token.wait();
+            release_front_batch();
+        }
+
+        memcpy(static_cast<char*>(_buffer->get_mapped_data()) + offset, values, static_cast<size_t>(size));
+
+        _head = offset + size;
+        _used_size += consumed_size;
+        _open_batch_size += consumed_size;
+
+        return staging_region{_buffer->get_vk_handle(), offset, size};
+    }
+
+    void staging_belt::close_batch(const submission_token& token)
+    {
+        if (_open_batch_size == 0)
+            return;
+
+        _batches.push_back({token, _open_batch_size});
+        _open_batch_size = 0;
+    }
+
+    void staging_belt::reclaim()
+    {
+        while (!_batches.empty() && _batches.front().token.is_complete())
+            release_front_batch();
+    }
+
+    void staging_belt::release_front_batch()
+    {
+        _used_size -= _batches.front().size;
+        _batches.pop_front();
+    }
+} // namespace owl::vulkan::core
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <deque>
+#include <memory>
+#include <optional>
+
+#include "buffer.h"
+#include "logical_device.h"
+#include "memory_allocator.h"
+#include "submission_service.h"
+
+namespace owl::vulkan::core
+{
+    struct staging_region
+    {
+        VkBuffer buffer;
+        VkDeviceSize offset;
+        VkDeviceSize size;
+    };
+
+    class staging_belt
+    {
+    public:
+        static constexpr VkDeviceSize default_budget = 32 * 1024 * 1024;
+        static constexpr VkDeviceSize default_alignment = 16;
+
+        staging_belt(const std::shared_ptr<memory_allocator>& memory_allocator,
+                     const std::shared_ptr<logical_device>& logical_device,
+                     VkDeviceSize budget = default_budget);
+        ~staging_belt();
+
+        VkDeviceSize get_budget() const { return _budget; }
+        VkDeviceSize get_used_size() const { return _used_size; }
+        size_t get_pending_batches_count() const { return _batches.size(); }
+
+        staging_region stage(const void* values, VkDeviceSize size, VkDeviceSize alignment = default_alignment);
+        std::optional<staging_region> try_stage(const void* values, VkDeviceSize size, VkDeviceSize alignment = default_alignment);
+        void close_batch(const submission_token& token);
+        void reclaim();
+
+    private:
+        struct batch
+        {
+            submission_token token;
+            VkDeviceSize size;
+        };
+
+        std::unique_ptr<buffer> _buffer;
+        VkDeviceSize _budget;
+
+        VkDeviceSize _head = 0;
+        VkDeviceSize _used_size = 0;
+        VkDeviceSize _open_batch_size = 0;
+
+        std::deque<batch> _batches;
+
+        void release_front_batch();
+    };
+} // namespace owl::vulkan::core
\ No newline at end of file
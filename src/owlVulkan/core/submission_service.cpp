@@ -0,0 +1,258 @@
+#include "submission_service.h"
+
+#include <stdexcept>
+#include <utility>
+
+#include "../helpers/vulkan_helpers.h"
+
+namespace owl::vulkan::core
+{
+    void submission_batch::add_command_buffer(VkCommandBuffer command_buffer)
+    {
+        if (command_buffers_count == max_command_buffers)
+            throw std::length_error("Too many command buffers in a submission batch.");
+
+        command_buffers[command_buffers_count++] = command_buffer;
+    }
+
+    void submission_batch::add_wait_semaphore(VkSemaphore semaphore, VkPipelineStageFlags wait_stage)
+    {
+        if (wait_semaphores_count == max_semaphores)
+            throw std::length_error("Too many wait semaphores in a submission batch.");
+
+        wait_semaphores[wait_semaphores_count] = semaphore;
+        wait_stages[wait_semaphores_count] = wait_stage;
+        ++wait_semaphores_count;
+    }
+
+    void submission_batch::add_signal_semaphore(VkSemaphore semaphore)
+    {
+        if (signal_semaphores_count == max_semaphores)
+            throw std::length_error("Too many signal semaphores in a submission batch.");
+
+        signal_semaphores[signal_semaphores_count++] = semaphore;
+    }
+
+    VkSubmitInfo submission_batch::get_vk_submit_info() const
+    {
+        VkSubmitInfo submit_info{};
+        submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submit_info.commandBufferCount = command_buffers_count;
+        submit_info.pCommandBuffers = command_buffers.data();
+        submit_info.waitSemaphoreCount = wait_semaphores_count;
+        submit_info.pWaitSemaphores = wait_semaphores.data();
+        submit_info.pWaitDstStageMask = wait_stages.data();
+        submit_info.signalSemaphoreCount = signal_semaphores_count;
+        submit_info.pSignalSemaphores = signal_semaphores.data();
+
+        return submit_info;
+    }
+
+    void submission_request::release()
+    {
+        if (references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            is_used.store(false, std::memory_order_release);
+    }
+
+    submission_token::submission_token(const std::shared_ptr<submission_service>& service, uint64_t value)
+        : _service(service)
+        , _value(value)
+    {
+    }
+
+    submission_token::submission_token(const std::shared_ptr<submission_service>& service, submission_request* request)
+        : _service(service)
+        , _request(request)
+    {
+    }
+
+    submission_token::~submission_token()
+    {
+        if (_request != nullptr)
+            _request->release();
+    }
+
+    submission_token::submission_token(const submission_token& other)
+        : _service(other._service)
+        , _request(other._request)
+        , _value(other._value)
+    {
+        if (_request != nullptr)
+            _request->add_reference();
+    }
+
+    submission_token::submission_token(submission_token&& other) noexcept
+        : _service(std::move(other._service))
+        , _request(std::exchange(other._request, nullptr))
+        , _value(other._value)
+    {
+    }
+
+    submission_token& submission_token::operator=(const submission_token& other)
+    {
+        if (this != &other)
+            *this = submission_token(other);
+
+        return *this;
+    }
+
+    submission_token& submission_token::operator=(submission_token&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+
+        if (_request != nullptr)
+            _request->release();
+
+        _service = std::move(other._service);
+        _request = std::exchange(other._request, nullptr);
+        _value = other._value;
+
+        return *this;
+    }
+
+    uint64_t submission_token::get_value() const
+    {
+        if (_request != nullptr)
+            return _request->value.load(std::memory_order_acquire);
+
+        return _value;
+    }
+
+    bool submission_token::is_submitted() const { return _request == nullptr || get_value() != 0; }
+
+    bool submission_token::is_failed() const { return _request != nullptr && get_value() == submission_request::failed_value; }
+
+    bool submission_token::is_complete() const
+    {
+        if (_service == nullptr)
+            return true;
+        if (is_failed())
+            throw std::runtime_error("Queued submission failed.");
+
+        return is_submitted() && _service->get_timeline()->is_complete(get_value());
+    }
+
+    void submission_token::wait() const
+    {
+        if (_service == nullptr)
+            return;
+
+        // a flush that started before ours may still hold the request, ours only returns once that one has submitted it
+        if (!is_submitted())
+            _service->flush();
+        if (is_failed())
+            throw std::runtime_error("Queued submission failed.");
+
+        _service->get_timeline()->wait(get_value());
+    }
+
+    submission_service::submission_service(const std::shared_ptr<logical_device>& logical_device, const VkQueue& vk_queue)
+        : _vk_queue(vk_queue)
+    {
+        _timeline = std::make_shared<queue_timeline>(logical_device, vk_queue);
+    }
+
+    submission_service::~submission_service()
+    {
+        // a failed flush has already marked its requests as failed, the error cannot leave a destructor
+        try
+        {
+            flush_pending_requests(nullptr);
+        }
+        catch (...)
+        {
+        }
+    }
+
+    submission_token submission_service::enqueue(const submission_batch& batch)
+    {
+        auto* request = acquire_request();
+        request->batch = batch;
+        request->value.store(0, std::memory_order_relaxed);
+        // one reference for the queue, one for the returned token
+        request->references.store(2, std::memory_order_relaxed);
+
+        // multiple producers push onto an intrusive stack, the single consumer takes the whole stack at once so there is no aba
+        auto* node = request;
+        node->next = _pending_requests.load(std::memory_order_relaxed);
+        while (!_pending_requests.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+
+        return submission_token(shared_from_this(), request);
+    }
+
+    submission_token submission_service::submit(const submission_batch& batch)
+    {
+        return submission_token(shared_from_this(), flush_pending_requests(&batch));
+    }
+
+    submission_token submission_service::flush() { return submission_token(shared_from_this(), flush_pending_requests(nullptr)); }
+
+    VkResult submission_service::present(const VkPresentInfoKHR& present_info)
+    {
+        std::lock_guard<std::mutex> lock(_queue_mutex);
+        return vkQueuePresentKHR(_vk_queue, &present_info);
+    }
+
+    submission_request* submission_service::acquire_request()
+    {
+        // slots are claimed with a compare exchange on their own flag, so there is no shared free list and no aba either
+        for (size_t attempt = 0; attempt < max_requests; ++attempt)
+        {
+            auto& request = _requests[_next_request_index.fetch_add(1, std::memory_order_relaxed) % max_requests];
+
+            bool is_used = false;
+            if (request.is_used.compare_exchange_strong(is_used, true, std::memory_order_acquire, std::memory_order_relaxed))
+                return &request;
+        }
+
+        throw std::length_error("Too many submission requests in flight.");
+    }
+
+    uint64_t submission_service::flush_pending_requests(const submission_batch* batch)
+    {
+        std::lock_guard<std::mutex> lock(_queue_mutex);
+
+        // the stack holds the newest request first, walking it backwards restores the order the batches were queued in
+        _flushed_requests.clear();
+        for (auto* node = _pending_requests.exchange(nullptr, std::memory_order_acquire); node != nullptr; node = node->next)
+            _flushed_requests.push_back(node);
+
+        _submit_infos.clear();
+        for (auto it = _flushed_requests.rbegin(); it != _flushed_requests.rend(); ++it)
+            _submit_infos.push_back((*it)->batch.get_vk_submit_info());
+        if (batch != nullptr)
+            _submit_infos.push_back(batch->get_vk_submit_info());
+
+        if (_submit_infos.empty())
+            return _timeline->get_submitted_value();
+
+        uint64_t value = 0;
+        try
+        {
+            value = _timeline->submit(_submit_infos.data(), static_cast<uint32_t>(_submit_infos.size()));
+        }
+        catch (...)
+        {
+            for (auto* request : _flushed_requests)
+            {
+                request->value.store(submission_request::failed_value, std::memory_order_release);
+                request->release();
+            }
+            throw;
+        }
+
+        _submit_calls_count.fetch_add(1, std::memory_order_relaxed);
+        _submitted_batches_count.fetch_add(_submit_infos.size(), std::memory_order_relaxed);
+
+        for (auto* request : _flushed_requests)
+        {
+            request->value.store(value, std::memory_order_release);
+            request->release();
+        }
+
+        return value;
+    }
+} // namespace owl::vulkan::core
\ No newline at end of file
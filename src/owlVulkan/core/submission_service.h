@@ -0,0 +1,123 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "logical_device.h"
+#include "queue_timeline.h"
+
+namespace owl::vulkan::core
+{
+    // one VkSubmitInfo worth of work, stored inline so batches can be queued from any thread without extra allocations
+    struct submission_batch
+    {
+        static constexpr uint32_t max_command_buffers = 4;
+        static constexpr uint32_t max_semaphores = 4;
+
+        std::array<VkCommandBuffer, max_command_buffers> command_buffers{};
+        std::array<VkSemaphore, max_semaphores> wait_semaphores{};
+        std::array<VkPipelineStageFlags, max_semaphores> wait_stages{};
+        std::array<VkSemaphore, max_semaphores> signal_semaphores{};
+        uint32_t command_buffers_count = 0;
+        uint32_t wait_semaphores_count = 0;
+        uint32_t signal_semaphores_count = 0;
+
+        void add_command_buffer(VkCommandBuffer command_buffer);
+        void add_wait_semaphore(VkSemaphore semaphore, VkPipelineStageFlags wait_stage);
+        void add_signal_semaphore(VkSemaphore semaphore);
+
+        VkSubmitInfo get_vk_submit_info() const;
+    };
+
+    // a slot of the service's fixed request pool, referenced by the queue until it is submitted and by every token copy
+    struct submission_request
+    {
+        static constexpr uint64_t failed_value = UINT64_MAX;
+
+        submission_batch batch;
+        std::atomic<uint64_t> value{0};
+        std::atomic<uint32_t> references{0};
+        std::atomic<bool> is_used{false};
+        submission_request* next = nullptr;
+
+        void add_reference() { references.fetch_add(1, std::memory_order_relaxed); }
+        void release();
+    };
+
+    class submission_service;
+
+    class submission_token
+    {
+    public:
+        submission_token() = default;
+        submission_token(const std::shared_ptr<submission_service>& service, uint64_t value);
+        // takes over one reference to the request
+        submission_token(const std::shared_ptr<submission_service>& service, submission_request* request);
+        ~submission_token();
+
+        submission_token(const submission_token& other);
+        submission_token(submission_token&& other) noexcept;
+        submission_token& operator=(const submission_token& other);
+        submission_token& operator=(submission_token&& other) noexcept;
+
+        // zero while the batch is still waiting in the service's queue
+        uint64_t get_value() const;
+        bool is_submitted() const;
+        // the vkQueueSubmit that carried the batch failed, completion queries and waits throw
+        bool is_failed() const;
+        bool is_complete() const;
+        void wait() const;
+
+    private:
+        std::shared_ptr<submission_service> _service;
+        submission_request* _request = nullptr;
+        uint64_t _value = 0;
+    };
+
+    // owns a VkQueue: batches are queued from any thread without locking and coalesced into a single vkQueueSubmit on the next
+    // flush, every queue access (submission and presentation) goes through the service so the queue is externally synchronized
+    class submission_service : public std::enable_shared_from_this<submission_service>
+    {
+    public:
+        static constexpr size_t max_requests = 256;
+
+        submission_service(const std::shared_ptr<logical_device>& logical_device, const VkQueue& vk_queue);
+        ~submission_service();
+
+        submission_service(const submission_service&) = delete;
+        submission_service& operator=(const submission_service&) = delete;
+
+        const VkQueue& get_vk_queue() const { return _vk_queue; }
+        const std::shared_ptr<queue_timeline>& get_timeline() const { return _timeline; }
+        uint64_t get_submit_calls_count() const { return _submit_calls_count.load(std::memory_order_relaxed); }
+        uint64_t get_submitted_batches_count() const { return _submitted_batches_count.load(std::memory_order_relaxed); }
+
+        submission_token enqueue(const submission_batch& batch);
+        submission_token submit(const submission_batch& batch);
+        submission_token flush();
+        VkResult present(const VkPresentInfoKHR& present_info);
+
+    private:
+        VkQueue _vk_queue;
+        std::shared_ptr<queue_timeline> _timeline;
+
+        std::array<submission_request, max_requests> _requests;
+        std::atomic<size_t> _next_request_index{0};
+        std::atomic<submission_request*> _pending_requests{nullptr};
+        std::atomic<uint64_t> _submit_calls_count{0};
+        std::atomic<uint64_t> _submitted_batches_count{0};
+
+        std::mutex _queue_mutex;
+        std::vector<submission_request*> _flushed_requests;
+        std::vector<VkSubmitInfo> _submit_infos;
+
+        submission_request* acquire_request();
+        uint64_t flush_pending_requests(const submission_batch* batch);
+    };
+} // namespace owl::vulkan::core
\ No newline at end of file
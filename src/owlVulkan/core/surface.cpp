@@ -8,5 +8,8 @@ namespace owl::vulkan::core
         _vk_handle = vk_surface;
     }
 
-    surface::~surface() { vkDestroySurfaceKHR(_instance->get_vk_handle(), _vk_handle, nullptr); }
+    surface::~surface()
+    {
+        vkDestroySurfaceKHR(_instance->get_vk_handle(), _vk_handle, _instance->get_allocation_callbacks(host_object_type::surface));
+    }
 } // namespace owl::vulkan
\ No newline at end of file
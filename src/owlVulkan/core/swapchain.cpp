@@ -12,31 +12,56 @@ namespace owl::vulkan::core
 {
     swapchain::swapchain(const std::shared_ptr<physical_device>& physical_device,
                          const std::shared_ptr<logical_device>& logical_device,
+                         const std::shared_ptr<memory_allocator>& memory_allocator,
                          const std::shared_ptr<surface>& surface,
                          const std::shared_ptr<render_pass>& render_pass,
                          const uint32_t width,
-                         const uint32_t height)
+                         const uint32_t height,
+                         VkPresentModeKHR preferred_presentation_mode,
+                         uint32_t requested_images_count,
+                         VkSharingMode requested_sharing_mode,
+                         const VkSwapchainKHR& old_swapchain)
         : _physical_device(physical_device)
         , _logical_device(logical_device)
+        , _memory_allocator(memory_allocator)
         , _surface(surface)
+        , _preferred_presentation_mode(preferred_presentation_mode)
+        , _requested_images_count(requested_images_count)
+        , _requested_sharing_mode(requested_sharing_mode)
     {
+        queue_families_indices indices = _physical_device->find_queue_families();
+        _graphics_family = indices.graphics_family.value();
+        _presentation_family = indices.presentation_family.value();
+
         VkSwapchainCreateInfoKHR create_info = create_swapchain_info(_physical_device, _surface->get_vk_handle(), width, height);
+        // the retired swapchain lets the driver recycle its resources, and its remaining images can still be presented
+        create_info.oldSwapchain = old_swapchain;
 
-        auto result = vkCreateSwapchainKHR(_logical_device->get_vk_handle(), &create_info, nullptr, &_vk_handle);
+        auto result = vkCreateSwapchainKHR(_logical_device->get_vk_handle(),
+                                           &create_info,
+                                           _logical_device->get_allocation_callbacks(host_object_type::swapchain),
+                                           &_vk_handle);
         vulkan::helpers::handle_result(result, "Failed to create swap chain");
 
         _vk_image_format = create_info.imageFormat;
         _vk_extent = create_info.imageExtent;
+        _vk_presentation_mode = create_info.presentMode;
+        _vk_sharing_mode = create_info.imageSharingMode;
         _vk_images = get_swapchain_images();
 
-        _color_image =
-            create_image(width, height, _vk_image_format, VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT);
+        _color_image = create_transient_image(width, height, _vk_image_format, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT);
         _color_image_view = create_image_view(_color_image->get_vk_handle(), _color_image->get_format(), VK_IMAGE_ASPECT_COLOR_BIT);
-        _depth_image = create_image(width, height, _physical_device->get_depth_format(), VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT);
+        _depth_image =
+            create_transient_image(width, height, _physical_device->get_depth_format(), VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT);
         _depth_image_view = create_image_view(_depth_image->get_vk_handle(), _depth_image->get_format(), VK_IMAGE_ASPECT_DEPTH_BIT);
     }
 
-    swapchain::~swapchain() { vkDestroySwapchainKHR(_logical_device->get_vk_handle(), _vk_handle, nullptr); }
+    swapchain::~swapchain()
+    {
+        vkDestroySwapchainKHR(_logical_device->get_vk_handle(),
+                              _vk_handle,
+                              _logical_device->get_allocation_callbacks(host_object_type::swapchain));
+    }
 
     VkSurfaceFormatKHR swapchain::choose_surface_format(const std::vector<VkSurfaceFormatKHR>& available_formats)
     {
@@ -51,11 +76,8 @@ namespace owl::vulkan::core
 
     VkPresentModeKHR swapchain::choose_presentation_mode(const std::vector<VkPresentModeKHR>& available_presentation_modes)
     {
-        const auto is_best_presentation_mode = [](const auto& presentation_mode) {
-            return presentation_mode == VK_PRESENT_MODE_MAILBOX_KHR;
-        };
-
-        auto it = std::find_if(available_presentation_modes.begin(), available_presentation_modes.end(), is_best_presentation_mode);
+        // fifo is the only mode every device has to support
+        auto it = std::find(available_presentation_modes.begin(), available_presentation_modes.end(), _preferred_presentation_mode);
 
         return it != available_presentation_modes.end() ? *it : VK_PRESENT_MODE_FIFO_KHR;
     }
@@ -75,6 +97,17 @@ namespace owl::vulkan::core
         }
     }
 
+    uint32_t swapchain::choose_images_count(const VkSurfaceCapabilitiesKHR& capabilities)
+    {
+        uint32_t images_count = _requested_images_count > 0 ? _requested_images_count : capabilities.minImageCount + 1;
+        images_count = std::max(images_count, capabilities.minImageCount);
+
+        if (capabilities.maxImageCount > 0 && images_count > capabilities.maxImageCount)
+            images_count = capabilities.maxImageCount;
+
+        return images_count;
+    }
+
     VkSwapchainCreateInfoKHR swapchain::create_swapchain_info(const std::shared_ptr<physical_device>& physical_device,
                                                               const VkSurfaceKHR& surface,
                                                               uint32_t width,
@@ -85,12 +118,7 @@ namespace owl::vulkan::core
         VkPresentModeKHR presentation_mode = choose_presentation_mode(swapchain_support.presentation_modes);
         VkExtent2D extent = choose_extent(swapchain_support.capabilities, width, height);
 
-        uint32_t images_count = swapchain_support.capabilities.minImageCount + 1;
-
-        if (swapchain_support.capabilities.maxImageCount > 0 && images_count > swapchain_support.capabilities.maxImageCount)
-        {
-            images_count = swapchain_support.capabilities.maxImageCount;
-        }
+        uint32_t images_count = choose_images_count(swapchain_support.capabilities);
 
         VkSwapchainCreateInfoKHR create_info{};
         create_info.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
@@ -102,10 +130,10 @@ namespace owl::vulkan::core
         create_info.imageArrayLayers = 1;
         create_info.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
 
-        queue_families_indices indices = _physical_device->find_queue_families();
-        uint32_t queue_families_indices[] = {indices.graphics_family.value(), indices.presentation_family.value()};
+        // concurrent sharing saves the ownership transfers but may keep the driver from compressing the images
+        uint32_t queue_families_indices[] = {_graphics_family, _presentation_family};
 
-        if (indices.graphics_family != indices.presentation_family)
+        if (_graphics_family != _presentation_family && _requested_sharing_mode == VK_SHARING_MODE_CONCURRENT)
         {
             create_info.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
             create_info.queueFamilyIndexCount = 2;
@@ -136,18 +164,21 @@ namespace owl::vulkan::core
         return helpers::getElements<VkImage>(function);
     }
 
-    std::shared_ptr<image> swapchain::create_image(uint32_t width, uint32_t height, VkFormat format, VkImageUsageFlags usage)
+    std::shared_ptr<image> swapchain::create_transient_image(uint32_t width, uint32_t height, VkFormat format, VkImageUsageFlags usage)
     {
-        return std::make_shared<vulkan::core::image>(_physical_device,
+        // multisampled color and depth never leave the render pass, so tile based devices can back them with lazily allocated memory
+        return std::make_shared<vulkan::core::image>(_memory_allocator,
                                                      _logical_device,
+                                                     memory_category::attachment,
                                                      width,
                                                      height,
                                                      1,
                                                      _physical_device->get_max_usable_sample_count(),
                                                      format,
                                                      VK_IMAGE_TILING_OPTIMAL,
-                                                     usage,
-                                                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+                                                     usage | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT,
+                                                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                     VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT);
     }
 
     std::shared_ptr<image_view> swapchain::create_image_view(const VkImage& vk_image, VkFormat format, VkImageAspectFlags aspect_flags)
@@ -170,4 +201,65 @@ namespace owl::vulkan::core
                                                                                 _vk_extent.height));
         }
     }
-} // namespace owl::vulkan::core
+
+    bool swapchain::requires_ownership_transfer() const
+    {
+        return _vk_sharing_mode == VK_SHARING_MODE_EXCLUSIVE && _graphics_family != _presentation_family;
+    }
+
+    void swapchain::release_image_to_presentation(const VkCommandBuffer& vk_command_buffer, size_t index) const
+    {
+        // the render pass already left the image in the present layout, the barrier only releases it to the presentation family
+        auto barrier = create_ownership_barrier(index);
+        barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        barrier.dstAccessMask = 0;
+
+        vkCmdPipelineBarrier(vk_command_buffer,
+                             VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                             VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr,
+                             1,
+                             &barrier);
+    }
+
+    void swapchain::acquire_image_for_presentation(const VkCommandBuffer& vk_command_buffer, size_t index) const
+    {
+        // the semaphore between the release and this acquire makes the color writes available, nothing has to be made visible
+        auto barrier = create_ownership_barrier(index);
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = 0;
+
+        vkCmdPipelineBarrier(vk_command_buffer,
+                             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                             VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr,
+                             1,
+                             &barrier);
+    }
+
+    VkImageMemoryBarrier swapchain::create_ownership_barrier(size_t index) const
+    {
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        barrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        barrier.srcQueueFamilyIndex = _graphics_family;
+        barrier.dstQueueFamilyIndex = _presentation_family;
+        barrier.image = _vk_images[index];
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.baseMipLevel = 0;
+        barrier.subresourceRange.levelCount = 1;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount = 1;
+
+        return barrier;
+    }
+} // namespace owl::vulkan::core
\ No newline at end of file
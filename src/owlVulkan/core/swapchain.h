@@ -10,6 +10,7 @@
 #include "image.h"
 #include "image_view.h"
 #include "logical_device.h"
+#include "memory_allocator.h"
 #include "physical_device.h"
 #include "render_pass.h"
 #include "surface.h"
@@ -22,28 +23,47 @@ namespace owl::vulkan::core
     public:
         swapchain(const std::shared_ptr<physical_device>& physical_device,
                   const std::shared_ptr<logical_device>& logical_device,
+                  const std::shared_ptr<memory_allocator>& memory_allocator,
                   const std::shared_ptr<surface>& surface,
                   const std::shared_ptr<render_pass>& render_pass,
                   const uint32_t width,
-                  const uint32_t height);
+                  const uint32_t height,
+                  VkPresentModeKHR preferred_presentation_mode = VK_PRESENT_MODE_MAILBOX_KHR,
+                  uint32_t requested_images_count = 0,
+                  VkSharingMode requested_sharing_mode = VK_SHARING_MODE_EXCLUSIVE,
+                  const VkSwapchainKHR& old_swapchain = VK_NULL_HANDLE);
         ~swapchain();
 
         const std::vector<VkImage>& get_vk_images() const { return _vk_images; };
         const VkFormat& get_vk_image_format() const { return _vk_image_format; };
         const VkExtent2D& get_vk_extent() const { return _vk_extent; };
+        VkPresentModeKHR get_vk_presentation_mode() const { return _vk_presentation_mode; }
+        VkSharingMode get_vk_sharing_mode() const { return _vk_sharing_mode; }
+        // exclusive images rendered on the graphics family have to be handed over to a different presentation family
+        bool requires_ownership_transfer() const;
         const std::shared_ptr<image>& get_color_image() const { return _color_image; }
         const std::shared_ptr<image>& get_depth_image() const { return _depth_image; }
         const std::vector<std::shared_ptr<framebuffer>>& get_framebuffers() const { return _framebuffers; }
 
         void create_framebuffers(const std::shared_ptr<render_pass>& render_pass);
+        void release_image_to_presentation(const VkCommandBuffer& vk_command_buffer, size_t index) const;
+        void acquire_image_for_presentation(const VkCommandBuffer& vk_command_buffer, size_t index) const;
 
     private:
         std::shared_ptr<physical_device> _physical_device;
         std::shared_ptr<logical_device> _logical_device;
+        std::shared_ptr<memory_allocator> _memory_allocator;
         std::shared_ptr<surface> _surface;
 
         VkFormat _vk_image_format;
         VkExtent2D _vk_extent;
+        VkPresentModeKHR _vk_presentation_mode;
+        VkPresentModeKHR _preferred_presentation_mode;
+        uint32_t _requested_images_count;
+        VkSharingMode _requested_sharing_mode;
+        VkSharingMode _vk_sharing_mode;
+        uint32_t _graphics_family;
+        uint32_t _presentation_family;
 
         std::vector<VkImage> _vk_images;
         std::shared_ptr<image> _color_image;
@@ -56,6 +76,7 @@ namespace owl::vulkan::core
         VkSurfaceFormatKHR choose_surface_format(const std::vector<VkSurfaceFormatKHR>& available_formats);
         VkPresentModeKHR choose_presentation_mode(const std::vector<VkPresentModeKHR>& available_presentation_modes);
         VkExtent2D choose_extent(const VkSurfaceCapabilitiesKHR& capabilities, uint32_t width, uint32_t height);
+        uint32_t choose_images_count(const VkSurfaceCapabilitiesKHR& capabilities);
 
         VkSwapchainCreateInfoKHR create_swapchain_info(const std::shared_ptr<physical_device>& physical_device,
                                                        const VkSurfaceKHR& surface,
@@ -63,7 +84,8 @@ namespace owl::vulkan::core
                                                        uint32_t height);
         std::vector<VkImage> get_swapchain_images();
 
-        std::shared_ptr<image> create_image(uint32_t width, uint32_t height, VkFormat format, VkImageUsageFlags usage);
+        std::shared_ptr<image> create_transient_image(uint32_t width, uint32_t height, VkFormat format, VkImageUsageFlags usage);
         std::shared_ptr<image_view> create_image_view(const VkImage& vk_image, VkFormat format, VkImageAspectFlags aspect_flags);
+        VkImageMemoryBarrier create_ownership_barrier(size_t index) const;
     };
 } // namespace owl::vulkan::core
@@ -0,0 +1,297 @@
+#include "upload_context.h"
+
+#include <algorithm>
+
+namespace owl::vulkan::core
+{
+    upload_context::upload_context(const std::shared_ptr<logical_device>& logical_device,
+                                   const std::shared_ptr<command_pool>& transfer_command_pool,
+                                   const std::shared_ptr<command_pool>& graphics_command_pool,
+                                   const std::shared_ptr<staging_belt>& staging_belt,
+                                   const std::shared_ptr<submission_service>& transfer_submissions,
+                                   const std::shared_ptr<submission_service>& graphics_submissions)
+        : _logical_device(logical_device)
+        , _transfer_command_pool(transfer_command_pool)
+        , _graphics_command_pool(graphics_command_pool)
+        , _staging_belt(staging_belt)
+        , _transfer_submissions(transfer_submissions)
+        , _graphics_submissions(graphics_submissions)
+    {
+        const auto& indices = _logical_device->get_queue_families_indices();
+        _transfer_family = indices.transfer_family.value();
+        _graphics_family = indices.graphics_family.value();
+        _requires_ownership_transfer = indices.requires_ownership_transfer();
+    }
+
+    upload_context::~upload_context()
+    {
+        // submissions complete in order on the graphics queue, so the last one covers the others
+        submit().wait();
+    }
+
+    const VkCommandBuffer& upload_context::get_vk_transfer_command_buffer()
+    {
+        if (_transfer_commands == nullptr)
+        {
+            _transfer_commands = std::make_unique<command_buffers>(_logical_device, _transfer_command_pool, 1);
+            _transfer_commands->begin(0, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+        }
+
+        return _transfer_commands->get_vk_command_buffers()[0];
+    }
+
+    const VkCommandBuffer& upload_context::get_vk_graphics_command_buffer()
+    {
+        if (_graphics_commands == nullptr)
+        {
+            _graphics_commands = std::make_unique<command_buffers>(_logical_device, _graphics_command_pool, 1);
+            _graphics_commands->begin(0, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+        }
+
+        return _graphics_commands->get_vk_command_buffers()[0];
+    }
+
+    staging_region upload_context::stage(const void* values, VkDeviceSize size, VkDeviceSize alignment)
+    {
+        auto region = _staging_belt->try_stage(values, size, alignment);
+        if (region)
+            return region.value();
+
+        // the belt is only filled by this batch, flush it so its space can be reclaimed
+        submit();
+
+        return _staging_belt->stage(values, size, alignment);
+    }
+
+    void upload_context::copy_buffer(buffer& destination, const void* values, VkDeviceSize size, VkDeviceSize destination_offset)
+    {
+        auto source_region = stage(values, size);
+        destination.copy_buffer(get_vk_transfer_command_buffer(), source_region, destination_offset);
+        release_to_graphics(destination);
+    }
+
+    void upload_context::copy_image(image& destination, const void* values, VkDeviceSize size)
+    {
+        auto source_region = stage(values, size);
+        destination.copy_buffer(get_vk_transfer_command_buffer(), source_region);
+        release_to_graphics(destination);
+    }
+
+    void upload_context::transition_layout(image& image, VkImageLayout new_layout)
+    {
+        if (new_layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
+        {
+            image.transition_layout(get_vk_transfer_command_buffer(), new_layout);
+            return;
+        }
+
+        acquire_on_graphics(image);
+        image.transition_layout(get_vk_graphics_command_buffer(), new_layout);
+    }
+
+    void upload_context::generate_mipmaps(image& image)
+    {
+        acquire_on_graphics(image);
+        image.generate_mipmaps(get_vk_graphics_command_buffer());
+    }
+
+    upload_token upload_context::submit()
+    {
+        reclaim();
+
+        if (_transfer_commands == nullptr && _graphics_commands == nullptr)
+            return _last_token;
+
+        submission submission{};
+
+        if (_transfer_commands != nullptr)
+        {
+            if (_requires_ownership_transfer)
+            {
+                vkCmdPipelineBarrier(_transfer_commands->get_vk_command_buffers()[0],
+                                     VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                     VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                     0,
+                                     0,
+                                     nullptr,
+                                     static_cast<uint32_t>(_buffer_ownership_barriers.size()),
+                                     _buffer_ownership_barriers.data(),
+                                     static_cast<uint32_t>(_image_ownership_barriers.size()),
+                                     _image_ownership_barriers.data());
+            }
+
+            _transfer_commands->end(0);
+
+            submission.transfer_semaphore = std::make_unique<semaphore>(_logical_device);
+
+            // the graphics batch waits on this binary semaphore, so its signal has to reach the queue first
+            submission_batch transfer_batch{};
+            transfer_batch.add_command_buffer(_transfer_commands->get_vk_command_buffers()[0]);
+            transfer_batch.add_signal_semaphore(submission.transfer_semaphore->get_vk_handle());
+            _transfer_submissions->submit(transfer_batch);
+            submission.transfer_commands = std::move(_transfer_commands);
+        }
+
+        acquire_pending_resources();
+
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+
+        vkCmdPipelineBarrier(get_vk_graphics_command_buffer(),
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                             0,
+                             1,
+                             &barrier,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr);
+
+        _graphics_commands->end(0);
+
+        // the acquire batch is only queued, it goes out with the next frame or with whoever waits on it first
+        submission_batch graphics_batch{};
+        graphics_batch.add_command_buffer(_graphics_commands->get_vk_command_buffers()[0]);
+        if (submission.transfer_semaphore != nullptr)
+            graphics_batch.add_wait_semaphore(submission.transfer_semaphore->get_vk_handle(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+
+        submission.token = _graphics_submissions->enqueue(graphics_batch);
+        _staging_belt->close_batch(submission.token);
+
+        submission.graphics_commands = std::move(_graphics_commands);
+        _last_token = submission.token;
+        _submissions.push_back(std::move(submission));
+
+        _buffer_ownership_barriers.clear();
+        _image_ownership_barriers.clear();
+        _acquired_images.clear();
+
+        return _last_token;
+    }
+
+    void upload_context::reclaim()
+    {
+        while (!_submissions.empty() && _submissions.front().token.is_complete())
+            _submissions.pop_front();
+
+        _staging_belt->reclaim();
+    }
+
+    void upload_context::release_to_graphics(const buffer& buffer)
+    {
+        if (!_requires_ownership_transfer)
+            return;
+
+        VkBufferMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = 0;
+        barrier.srcQueueFamilyIndex = _transfer_family;
+        barrier.dstQueueFamilyIndex = _graphics_family;
+        barrier.buffer = buffer.get_vk_handle();
+        barrier.offset = 0;
+        barrier.size = VK_WHOLE_SIZE;
+
+        _buffer_ownership_barriers.push_back(barrier);
+    }
+
+    void upload_context::release_to_graphics(const image& image)
+    {
+        if (!_requires_ownership_transfer)
+            return;
+
+        auto is_released = std::any_of(_image_ownership_barriers.begin(),
+                                       _image_ownership_barriers.end(),
+                                       [&image](const VkImageMemoryBarrier& barrier) { return barrier.image == image.get_vk_handle(); });
+        if (is_released)
+            return;
+
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = 0;
+        barrier.oldLayout = image.get_layout();
+        barrier.newLayout = image.get_layout();
+        barrier.srcQueueFamilyIndex = _transfer_family;
+        barrier.dstQueueFamilyIndex = _graphics_family;
+        barrier.image = image.get_vk_handle();
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.baseMipLevel = 0;
+        barrier.subresourceRange.levelCount = image.get_mip_levels();
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount = 1;
+
+        _image_ownership_barriers.push_back(barrier);
+    }
+
+    void upload_context::acquire_on_graphics(const image& image)
+    {
+        if (!_requires_ownership_transfer || _acquired_images.count(image.get_vk_handle()) > 0)
+            return;
+
+        auto released_barrier =
+            std::find_if(_image_ownership_barriers.begin(), _image_ownership_barriers.end(), [&image](const VkImageMemoryBarrier& barrier) {
+                return barrier.image == image.get_vk_handle();
+            });
+        if (released_barrier == _image_ownership_barriers.end())
+            return;
+
+        VkImageMemoryBarrier barrier = *released_barrier;
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
+
+        vkCmdPipelineBarrier(get_vk_graphics_command_buffer(),
+                             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr,
+                             1,
+                             &barrier);
+
+        _acquired_images.insert(image.get_vk_handle());
+    }
+
+    void upload_context::acquire_pending_resources()
+    {
+        if (!_requires_ownership_transfer)
+            return;
+
+        std::vector<VkBufferMemoryBarrier> buffer_barriers = _buffer_ownership_barriers;
+        for (auto& barrier : buffer_barriers)
+        {
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+        }
+
+        std::vector<VkImageMemoryBarrier> image_barriers;
+        for (auto barrier : _image_ownership_barriers)
+        {
+            if (_acquired_images.count(barrier.image) > 0)
+                continue;
+
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+            image_barriers.push_back(barrier);
+        }
+
+        if (buffer_barriers.empty() && image_barriers.empty())
+            return;
+
+        vkCmdPipelineBarrier(get_vk_graphics_command_buffer(),
+                             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                             VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             static_cast<uint32_t>(buffer_barriers.size()),
+                             buffer_barriers.data(),
+                             static_cast<uint32_t>(image_barriers.size()),
+                             image_barriers.data());
+    }
+} // namespace owl::vulkan::core
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <deque>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "buffer.h"
+#include "command_buffers.h"
+#include "command_pool.h"
+#include "image.h"
+#include "logical_device.h"
+#include "semaphore.h"
+#include "staging_belt.h"
+#include "submission_service.h"
+
+namespace owl::vulkan::core
+{
+    // an upload completes with the graphics batch that acquires its resources
+    using upload_token = submission_token;
+
+    class upload_context
+    {
+    public:
+        upload_context(const std::shared_ptr<logical_device>& logical_device,
+                       const std::shared_ptr<command_pool>& transfer_command_pool,
+                       const std::shared_ptr<command_pool>& graphics_command_pool,
+                       const std::shared_ptr<staging_belt>& staging_belt,
+                       const std::shared_ptr<submission_service>& transfer_submissions,
+                       const std::shared_ptr<submission_service>& graphics_submissions);
+        ~upload_context();
+
+        const VkCommandBuffer& get_vk_transfer_command_buffer();
+        const VkCommandBuffer& get_vk_graphics_command_buffer();
+
+        staging_region stage(const void* values, VkDeviceSize size, VkDeviceSize alignment = staging_belt::default_alignment);
+        void copy_buffer(buffer& destination, const void* values, VkDeviceSize size, VkDeviceSize destination_offset = 0);
+        void copy_image(image& destination, const void* values, VkDeviceSize size);
+        void transition_layout(image& image, VkImageLayout new_layout);
+        void generate_mipmaps(image& image);
+
+        upload_token submit();
+        void reclaim();
+
+    private:
+        struct submission
+        {
+            std::unique_ptr<command_buffers> transfer_commands;
+            std::unique_ptr<command_buffers> graphics_commands;
+            std::unique_ptr<semaphore> transfer_semaphore;
+            upload_token token;
+        };
+
+        std::shared_ptr<logical_device> _logical_device;
+        std::shared_ptr<command_pool> _transfer_command_pool;
+        std::shared_ptr<command_pool> _graphics_command_pool;
+        std::shared_ptr<staging_belt> _staging_belt;
+        std::shared_ptr<submission_service> _transfer_submissions;
+        std::shared_ptr<submission_service> _graphics_submissions;
+        uint32_t _transfer_family;
+        uint32_t _graphics_family;
+        bool _requires_ownership_transfer;
+
+        std::unique_ptr<command_buffers> _transfer_commands;
+        std::unique_ptr<command_buffers> _graphics_commands;
+        std::vector<VkBufferMemoryBarrier> _buffer_ownership_barriers;
+        std::vector<VkImageMemoryBarrier> _image_ownership_barriers;
+        std::set<VkImage> _acquired_images;
+
+        std::deque<submission> _submissions;
+        upload_token _last_token;
+
+        void release_to_graphics(const buffer& buffer);
+        void release_to_graphics(const image& image);
+        void acquire_on_graphics(const image& image);
+        void acquire_pending_resources();
+    };
+} // namespace owl::vulkan::core
\ No newline at end of file
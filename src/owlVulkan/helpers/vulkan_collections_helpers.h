@@ -2,6 +2,7 @@
 
 #include <vulkan/vulkan.h>
 
+#include <memory_resource>
 #include <vector>
 
 namespace owl::vulkan::helpers
@@ -12,6 +13,9 @@ namespace owl::vulkan::helpers
     template <typename TElement, typename TFunction>
     std::vector<TElement> getElements(TFunction function);
 
+    template <typename TElement, typename TFunction>
+    std::pmr::vector<TElement> getElements(TFunction function, std::pmr::memory_resource* memory_resource);
+
     /////////////////////////////////////////////////TEMPLATE DEFINITIONS//////////////////////////////////////////////////
 
     template <typename TElement, typename TFunction>
@@ -25,4 +29,15 @@ namespace owl::vulkan::helpers
 
         return elements;
     }
+
+    template <typename TElement, typename TFunction>
+    std::pmr::vector<TElement> getElements(TFunction function, std::pmr::memory_resource* memory_resource)
+    {
+        uint32_t elements_count;
+        auto result1 = function(&elements_count, nullptr);
+        std::pmr::vector<TElement> elements(elements_count, memory_resource);
+        auto result2 = function(&elements_count, elements.data());
+
+        return elements;
+    }
 } // namespace owl::vulkan::helpers
@@ -15,6 +15,15 @@ namespace owl::vulkan::helpers
             handle_result_error(result, error_message);
     }
 
+    void handle_result(VkResult result, const char* error_message, bool throw_on_error)
+    {
+        // the message is only turned into a string on failure, so checking a result on a hot path does not allocate
+        if (has_operation_succeeded(result))
+            return;
+
+        handle_result(result, std::string(error_message), throw_on_error);
+    }
+
     bool has_operation_succeeded(VkResult result) { return result == VK_SUCCESS; }
 
     void handle_result_error(VkResult result, const std::string& error_message)
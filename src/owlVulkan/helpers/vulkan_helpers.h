@@ -8,6 +8,7 @@
 namespace owl::vulkan::helpers
 {
     void handle_result(VkResult result, const std::string& error_message, bool throw_on_error = true);
+    void handle_result(VkResult result, const char* error_message, bool throw_on_error = true);
     bool has_operation_succeeded(VkResult result);
     void handle_result_error(VkResult result, const std::string& error_message);
     void log_result_error(VkResult result, const std::string& error_message);
@@ -5,4 +5,6 @@
 namespace owl::vulkan
 {
     bool queue_families_indices::is_complete() { return graphics_family.has_value() && presentation_family.has_value(); }
+
+    bool queue_families_indices::requires_ownership_transfer() const { return transfer_family != graphics_family; }
 } // namespace owl::vulkan
@@ -10,7 +10,10 @@ namespace owl::vulkan
     {
         std::optional<uint32_t> graphics_family;
         std::optional<uint32_t> presentation_family;
+        std::optional<uint32_t> transfer_family;
+        uint32_t transfer_queue_index = 0;
 
         bool is_complete();
+        bool requires_ownership_transfer() const;
     };
 } // namespace owl::vulkan
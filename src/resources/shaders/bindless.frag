@@ -0,0 +1,37 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+struct material
+{
+    uint texture_index;
+    uint padding0;
+    uint padding1;
+    uint padding2;
+    vec4 tint;
+};
+
+layout(set = 1, binding = 0) readonly buffer material_table
+{
+    material materials[];
+} storage_buffers[];
+
+layout(set = 1, binding = 1) uniform sampler texture_sampler;
+layout(set = 1, binding = 2) uniform texture2D textures[];
+
+// the material id is the same for the whole draw, so indexing the tables with it stays dynamically uniform
+layout(push_constant) uniform draw_constants
+{
+    uint material_id;
+} draw;
+
+layout(location = 0) in vec3 fragment_color;
+layout(location = 1) in vec2 fragment_texture_coordinate;
+
+layout(location = 0) out vec4 out_color;
+
+void main()
+{
+    material draw_material = storage_buffers[0].materials[draw.material_id];
+    vec4 texture_color = texture(sampler2D(textures[draw_material.texture_index], texture_sampler), fragment_texture_coordinate);
+    out_color = texture_color * draw_material.tint;
+}
@@ -0,0 +1,31 @@
+#include "simulation.h"
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace owl
+{
+    simulation::simulation()
+        : _last_update_time(std::chrono::steady_clock::now())
+    {
+    }
+
+    void simulation::update(frame_state& state, std::chrono::steady_clock::time_point input_time)
+    {
+        // a paused animation keeps its time, so its snapshots keep the same content
+        if (!_is_paused)
+        {
+            _animation_time += std::chrono::duration<float, std::chrono::seconds::period>(input_time - _last_update_time).count();
+            ++_content_version;
+        }
+        _last_update_time = input_time;
+
+        state.sequence = ++_sequence;
+        state.content_version = _content_version;
+        state.time = _animation_time;
+        state.model = glm::rotate(glm::mat4(1.0f), _animation_time * glm::radians(45.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+        state.view = glm::lookAt(glm::vec3(2.0f, 2.0f, 2.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+        state.input_time = input_time;
+    }
+} // namespace owl
\ No newline at end of file
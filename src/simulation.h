@@ -0,0 +1,27 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "frame_state.h"
+
+namespace owl
+{
+    class simulation
+    {
+    public:
+        simulation();
+
+        bool is_paused() const { return _is_paused; }
+        void set_paused(bool is_paused) { _is_paused = is_paused; }
+
+        void update(frame_state& state, std::chrono::steady_clock::time_point input_time);
+
+    private:
+        std::chrono::steady_clock::time_point _last_update_time;
+        float _animation_time = 0.0f;
+        bool _is_paused = false;
+        uint64_t _sequence = 0;
+        uint64_t _content_version = 0;
+    };
+} // namespace owl
\ No newline at end of file
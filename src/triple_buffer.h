@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace owl
+{
+    // lock-free single producer single consumer handoff: the writer always has a buffer to fill, the reader always sees the
+    // latest complete one, and neither ever waits for the other; intermediate values the reader did not pick up are dropped
+    template <typename TValue>
+    class triple_buffer
+    {
+    public:
+        triple_buffer() = default;
+
+        triple_buffer(const triple_buffer&) = delete;
+        triple_buffer& operator=(const triple_buffer&) = delete;
+
+        // writer side
+        TValue& get_write_buffer() { return _buffers[_write_index]; }
+        void publish();
+
+        // reader side
+        bool update();
+        const TValue& get_read_buffer() const { return _buffers[_read_index]; }
+
+    private:
+        static constexpr uint8_t index_mask = 0x3;
+        static constexpr uint8_t fresh_bit = 0x4;
+
+        std::array<TValue, 3> _buffers{};
+
+        // index of the buffer in between the two sides, flagged when it holds a value the reader has not taken yet
+        alignas(64) std::atomic<uint8_t> _shared_state{1};
+        alignas(64) uint8_t _write_index = 0;
+        alignas(64) uint8_t _read_index = 2;
+    };
+
+    template <typename TValue>
+    void triple_buffer<TValue>::publish()
+    {
+        auto previous_state = _shared_state.exchange(static_cast<uint8_t>(_write_index | fresh_bit), std::memory_order_acq_rel);
+        _write_index = previous_state & index_mask;
+    }
+
+    template <typename TValue>
+    bool triple_buffer<TValue>::update()
+    {
+        if ((_shared_state.load(std::memory_order_relaxed) & fresh_bit) == 0)
+            return false;
+
+        auto previous_state = _shared_state.exchange(_read_index, std::memory_order_acq_rel);
+        _read_index = previous_state & index_mask;
+
+        return true;
+    }
+} // namespace owl
\ No newline at end of file
@@ -3,7 +3,9 @@
 #include <algorithm>
 #include <chrono>
 #include <cstring>
+#include <fstream>
 #include <iostream>
+#include <random>
 #include <set>
 #include <stdexcept>
 #include <unordered_map>
@@ -13,6 +15,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <core/swapchain.h>
+#include <heap_allocation_counter.h>
 #include <helpers/vulkan_collections_helpers.h>
 #include <helpers/vulkan_helpers.h>
 #include <matrix.h>
@@ -20,33 +23,60 @@
 
 namespace owl
 {
-    vulkan_engine::vulkan_engine() {}
+    vulkan_engine::vulkan_engine(const engine_settings& settings)
+        : _settings(settings)
+        , _deletion_queue(std::make_shared<vulkan::core::deletion_queue>())
+    {
+        _settings.validate();
+    }
 
     vulkan_engine::~vulkan_engine()
     {
-        clean_swapchain();
+        // the owner waited for the device to be idle, so every retired resource can be released
+        _deletion_queue->flush();
 
-        _texture_sampler = nullptr;
-        _texture_image_view = nullptr;
+        _presentation_command_buffers = nullptr;
+        _command_buffers = nullptr;
+        _render_pass = nullptr;
+        _swapchain = nullptr;
+        _uniform_buffer = nullptr;
+        _descriptor_sets = nullptr;
+        _push_descriptors = nullptr;
+        _descriptor_update_template = nullptr;
+        _descriptor_allocator = nullptr;
+        _bindless_table = nullptr;
+        _material_buffer = nullptr;
+
+        _samplers.clear();
+        _image_views.clear();
         _texture_image = nullptr;
         _descriptor_set_layout = nullptr;
 
-        _index_buffer = nullptr;
-        _vertex_buffer = nullptr;
+        _geometry_pool = nullptr;
 
-        for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
-        {
-            _in_flight_fences.clear();
-            _render_finished_semaphores.clear();
-            _image_available_semaphores.clear();
-        }
+        _ownership_released_semaphores.clear();
+        _render_finished_semaphores.clear();
+        _image_available_semaphores.clear();
 
         _pipeline_layout = nullptr;
         _graphics_pipeline = nullptr;
+        _defragmenter = nullptr;
+        _upload_context = nullptr;
+        _staging_belt = nullptr;
+        _graphics_timeline = nullptr;
+        _transfer_submissions = nullptr;
+        _presentation_submissions = nullptr;
+        _graphics_submissions = nullptr;
+        _presentation_command_pool = nullptr;
+        _transfer_command_pool = nullptr;
         _command_pool == nullptr;
+        _frame_arena = nullptr;
+        _memory_allocator = nullptr;
+        _memory_tracker = nullptr;
         _logical_device = nullptr;
         _surface = nullptr;
         _instance = nullptr;
+        _host_allocator = nullptr;
     }
 
     void vulkan_engine::create_instance(std::vector<const char*>&& extensions)
@@ -54,7 +84,15 @@ namespace owl
         if (enable_validation_layers)
             extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
 
-        _instance = std::make_shared<vulkan::core::instance>(enable_validation_layers, validation_layers, extensions);
+        auto available_extensions = vulkan::helpers::get_instance_extension_properties();
+        auto is_properties2_available = std::any_of(available_extensions.begin(), available_extensions.end(), [](const auto& extension) {
+            return strcmp(extension.extensionName, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) == 0;
+        });
+        if (is_properties2_available)
+            extensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+
+        _host_allocator = std::make_shared<vulkan::core::host_allocator>();
+        _instance = std::make_shared<vulkan::core::instance>(enable_validation_layers, validation_layers, extensions, _host_allocator);
 
         display_available_extensions();
     }
@@ -67,45 +105,83 @@ namespace owl
     void vulkan_engine::initialize(uint32_t width, uint32_t height, mesh&& mesh, texture&& texture)
     {
         _physical_device = std::make_shared<vulkan::core::physical_device>(_instance, _surface, device_extensions);
+
+        auto enabled_device_extensions = device_extensions;
+        bool is_memory_budget_enabled = _instance->is_extension_enabled(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) &&
+                                        _physical_device->supports_extension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+        if (is_memory_budget_enabled)
+            enabled_device_extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+        enable_descriptor_binding_extensions(enabled_device_extensions);
+        bool is_descriptor_indexing_enabled = _settings.is_bindless_enabled && _physical_device->supports_descriptor_indexing();
+
         _logical_device = std::make_shared<vulkan::core::logical_device>(_physical_device,
                                                                          _surface,
-                                                                         device_extensions,
+                                                                         enabled_device_extensions,
                                                                          validation_layers,
-                                                                         enable_validation_layers);
+                                                                         enable_validation_layers,
+                                                                         _host_allocator,
+                                                                         _physical_device->supports_timeline_semaphores(),
+                                                                         is_descriptor_indexing_enabled);
+        create_submission_services();
+        _memory_tracker = std::make_shared<vulkan::core::memory_tracker>(_instance, _physical_device, is_memory_budget_enabled);
+        _memory_allocator = std::make_shared<vulkan::core::memory_allocator>(_physical_device, _logical_device, _memory_tracker);
+        _frame_arena = std::make_shared<vulkan::core::frame_arena>();
 
         auto indices = _physical_device->find_queue_families();
         _command_pool = std::make_shared<vulkan::core::command_pool>(_logical_device, _surface, indices.graphics_family.value());
+        _transfer_command_pool = std::make_shared<vulkan::core::command_pool>(_logical_device, _surface, indices.transfer_family.value());
+        if (indices.graphics_family != indices.presentation_family)
+            _presentation_command_pool =
+                std::make_shared<vulkan::core::command_pool>(_logical_device, _surface, indices.presentation_family.value());
+        _staging_belt = std::make_shared<vulkan::core::staging_belt>(_memory_allocator, _logical_device, STAGING_BELT_BUDGET);
+        _upload_context = std::make_shared<vulkan::core::upload_context>(_logical_device,
+                                                                         _transfer_command_pool,
+                                                                         _command_pool,
+                                                                         _staging_belt,
+                                                                         _transfer_submissions,
+                                                                         _graphics_submissions);
 
         create_swapchain(width, height); // swapchain
         create_render_pass();            // swapchain
         _swapchain->create_framebuffers(_render_pass);
         create_texture_resources(std::move(texture)); // TODO merge with image view // need command pool
 
-        _indices_size = static_cast<uint32_t>(mesh.indices.size());
         create_buffers(std::move(mesh)); // use mesh // need command pool
+        if (is_descriptor_indexing_enabled)
+            create_bindless_resources(); // need texture resources and meshes
+        _upload_context->submit().wait();
 
         create_uniform_buffers(); // swapchain
-        create_descriptor_pool(); // swapchain
+        create_descriptor_allocator();
 
-        _descriptor_set_layout = std::make_shared<vulkan::core::descriptor_set_layout>(_logical_device);
-        _pipeline_layout = std::make_shared<vulkan::core::pipeline_layout>(_logical_device, _descriptor_set_layout);
-        _graphics_pipeline = std::make_shared<vulkan::core::graphics_pipeline>("../build/shaders/passthrough_frag.spv",
-                                                                               "../build/shaders/passthrough_vert.spv",
-                                                                               _logical_device,
-                                                                               _swapchain,
-                                                                               _pipeline_layout,
-                                                                               _render_pass,
-                                                                               _physical_device->get_max_usable_sample_count());
+        _descriptor_set_layout = std::make_shared<vulkan::core::descriptor_set_layout>(
+            _logical_device, _descriptor_binding_mode == descriptor_binding_mode::push_descriptors);
+        create_pipeline_layout();
+        create_graphics_pipeline();
+        create_descriptor_binding();
 
-        create_descriptor_sets();              // swapchain // need descriptor_set_layout
-        create_command_buffers(_indices_size); // swapchain // need pipeline_layout, graphics_pipeline, command_pool
+        create_descriptor_sets(); // swapchain // need descriptor_set_layout
+        create_command_buffers(); // swapchain // need pipeline_layout, graphics_pipeline, command_pool
+        create_presentation_command_buffers();
 
         create_synchronization_objects();
+
+        _defragmenter = std::make_shared<vulkan::core::defragmenter>(_memory_allocator, _upload_context, _deletion_queue);
+        register_movable_resources();
     }
 
     bool vulkan_engine::acquire_image()
     {
-        _in_flight_fences[_current_frame]->wait_for_fence();
+        begin_frame();
+
+        if (_resources_moved)
+            rebuild_moved_resources();
+
+        _graphics_timeline->wait(_in_flight_frame_values[_current_frame]);
+        _deletion_queue->collect(_graphics_timeline->get_completed_value());
+
+        if (_settings.is_latency_measurement_enabled)
+            _latency_tracker.record_completion(_current_frame);
 
         VkResult acquire_result = vkAcquireNextImageKHR(_logical_device->get_vk_handle(),
                                                         _swapchain->get_vk_handle(),
@@ -122,35 +198,48 @@ namespace owl
         return true;
     }
 
-    bool vulkan_engine::draw_image()
+    bool vulkan_engine::draw_image(const frame_state_latch& latch_state)
     {
-        update_uniform_buffers(_current_image_index);
+        _graphics_timeline->wait(_in_flight_image_values[_current_image_index]);
 
-        if (_in_flight_images[_current_image_index] != nullptr)
-            _in_flight_images[_current_image_index]->wait_for_fence();
+        // late latch: the image's constants region is free only now, so the camera and transforms are written from the newest
+        // snapshot right before the submission instead of from the one the frame started with
+        const auto& state = latch_state();
+        update_uniform_buffers(_current_image_index, state);
+        if (_settings.is_latency_measurement_enabled)
+            _latency_tracker.sample_input(state.sequence, state.input_time);
 
-        _in_flight_images[_current_image_index] = _in_flight_fences[_current_frame];
+        VkSemaphore signal_semaphores[] = {_render_finished_semaphores[_current_frame]->get_vk_handle()};
+        bool is_ownership_transferred = _presentation_command_buffers != nullptr;
 
-        VkSemaphore wait_semaphores[] = {_image_available_semaphores[_current_frame]->get_vk_handle()};
-        VkPipelineStageFlags wait_stages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
+        vulkan::core::submission_batch frame_batch{};
+        frame_batch.add_wait_semaphore(_image_available_semaphores[_current_frame]->get_vk_handle(),
+                                       VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+        frame_batch.add_command_buffer(_command_buffers->get_vk_command_buffers()[_current_image_index]);
+        frame_batch.add_signal_semaphore(is_ownership_transferred ? _ownership_released_semaphores[_current_frame]->get_vk_handle()
+                                                                  : signal_semaphores[0]);
 
-        VkSubmitInfo submit_info{};
-        submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submit_info.waitSemaphoreCount = 1;
-        submit_info.pWaitSemaphores = wait_semaphores;
-        submit_info.pWaitDstStageMask = wait_stages;
-        submit_info.commandBufferCount = 1;
-        submit_info.pCommandBuffers = &_command_buffers->get_vk_command_buffers()[_current_image_index];
+        // batches queued by other threads since the last frame go out in the same vkQueueSubmit, ahead of the frame
+        auto frame_value = _graphics_submissions->submit(frame_batch).get_value();
+        if (_settings.is_latency_measurement_enabled)
+            _latency_tracker.record_submit();
 
-        VkSemaphore signal_semaphores[] = {_render_finished_semaphores[_current_frame]->get_vk_handle()};
-        submit_info.signalSemaphoreCount = 1;
-        submit_info.pSignalSemaphores = signal_semaphores;
+        if (is_ownership_transferred)
+        {
+            // the presentation family acquires the image released by the frame before presenting it
+            vulkan::core::submission_batch presentation_batch{};
+            presentation_batch.add_wait_semaphore(_ownership_released_semaphores[_current_frame]->get_vk_handle(),
+                                                  VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+            presentation_batch.add_command_buffer(_presentation_command_buffers->get_vk_command_buffers()[_current_image_index]);
+            presentation_batch.add_signal_semaphore(signal_semaphores[0]);
+            _presentation_submissions->submit(presentation_batch);
+        }
 
-        vkResetFences(_logical_device->get_vk_handle(), 1, &_in_flight_fences[_current_frame]->get_vk_handle());
+        _in_flight_frame_values[_current_frame] = frame_value;
+        _in_flight_image_values[_current_image_index] = frame_value;
 
-        auto result =
-            vkQueueSubmit(_logical_device->get_vk_graphics_queue(), 1, &submit_info, _in_flight_fences[_current_frame]->get_vk_handle());
-        vulkan::helpers::handle_result(result, "Failed to submit draw command buffer");
+        // resources retired from now on may be used by this frame, so they are released once it is complete
+        _deletion_queue->set_submitted_value(frame_value);
 
         VkPresentInfoKHR presentation_info{};
         presentation_info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
@@ -163,25 +252,70 @@ namespace owl
         presentation_info.pImageIndices = &_current_image_index;
         presentation_info.pResults = nullptr;
 
-        VkResult presentation_result = vkQueuePresentKHR(_logical_device->get_vk_presentation_queue(), &presentation_info);
+        VkResult presentation_result = _presentation_submissions->present(presentation_info);
 
-        if (presentation_result == VK_ERROR_OUT_OF_DATE_KHR || presentation_result == VK_SUBOPTIMAL_KHR || _framebuffer_resized)
-        {
-            _framebuffer_resized = false;
+        if (_settings.is_latency_measurement_enabled)
+            _latency_tracker.record_present(_current_frame);
+
+        _defragmenter->step(DEFRAGMENTATION_TIME_BUDGET, DEFRAGMENTATION_SIZE_BUDGET);
+        compact_geometry();
+
+        if (!_memory_report_path.empty())
+            write_memory_report();
+
+        bool is_framebuffer_resized = _framebuffer_resized.exchange(false);
+        if (presentation_result == VK_ERROR_OUT_OF_DATE_KHR || presentation_result == VK_SUBOPTIMAL_KHR || is_framebuffer_resized)
             return false;
-        }
         else if (presentation_result != VK_SUCCESS)
         {
             vulkan::helpers::handle_result_error(presentation_result, "Failed to acquire swapchain image.");
         }
 
-        _current_frame = (_current_frame + 1) % MAX_FRAMES_IN_FLIGHT;
+        _current_frame = (_current_frame + 1) % _settings.frames_in_flight;
 
         return true;
     }
 
     void vulkan_engine::wait_idle() { _logical_device->wait_idle(); }
 
+    void vulkan_engine::set_settings(const engine_settings& settings)
+    {
+        settings.validate();
+
+        bool is_swapchain_changed = settings.presentation_mode != _settings.presentation_mode ||
+                                    settings.swapchain_images_count != _settings.swapchain_images_count ||
+                                    settings.is_concurrent_swapchain_sharing_enabled != _settings.is_concurrent_swapchain_sharing_enabled;
+        bool is_frames_in_flight_changed = settings.frames_in_flight != _settings.frames_in_flight;
+        _settings = settings;
+
+        if (_logical_device == nullptr)
+            return;
+
+        if (is_frames_in_flight_changed)
+        {
+            // the semaphores of the previous frames may still be pending, the new frame slots start behind the last submission
+            _deletion_queue->enqueue([image_available_semaphores = std::move(_image_available_semaphores),
+                                      render_finished_semaphores = std::move(_render_finished_semaphores),
+                                      ownership_released_semaphores = std::move(_ownership_released_semaphores)]() {});
+            _current_frame = 0;
+            create_synchronization_objects();
+        }
+
+        // the window recreates the swapchain when presentation reports a resize
+        if (is_swapchain_changed)
+            _framebuffer_resized = true;
+    }
+
+    void vulkan_engine::begin_frame()
+    {
+        auto heap_allocations_count = get_heap_allocations_count();
+        _frame_heap_allocations_count = heap_allocations_count - _frame_start_heap_allocations_count;
+        _frame_start_heap_allocations_count = heap_allocations_count;
+
+        _frame_arena->reset();
+        _deletion_queue->set_submitted_value(_graphics_timeline->get_submitted_value());
+    }
+
     void vulkan_engine::display_available_extensions()
     {
         std::vector<VkExtensionProperties> extensions = vulkan::helpers::get_instance_extension_properties();
@@ -193,43 +327,135 @@ namespace owl
 
     void vulkan_engine::create_buffers(mesh&& mesh)
     {
-        _vertex_buffer = vulkan::core::create_buffer(mesh.vertices,
-                                                     _physical_device,
-                                                     _logical_device,
-                                                     _command_pool,
-                                                     VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
-        _index_buffer = vulkan::core::create_buffer(mesh.indices,
-                                                    _physical_device,
-                                                    _logical_device,
-                                                    _command_pool,
-                                                    VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+        _geometry_pool = std::make_shared<vulkan::core::geometry_pool>(_memory_allocator,
+                                                                       _logical_device,
+                                                                       _upload_context,
+                                                                       _deletion_queue,
+                                                                       static_cast<uint32_t>(sizeof(vertex)),
+                                                                       GEOMETRY_POOL_VERTICES_CAPACITY,
+                                                                       GEOMETRY_POOL_INDICES_CAPACITY);
+        _meshes.push_back(_geometry_pool->add(mesh.vertices, mesh.indices));
     }
 
     void vulkan_engine::create_uniform_buffers()
     {
-        VkDeviceSize buffer_size = sizeof(vulkan::model_view_projection);
-        _uniform_buffers.resize(_swapchain->get_vk_images().size());
+        // command buffers are recorded once per swapchain image, so each image owns the region its dynamic offset points to
+        auto uniform_alignment = _physical_device->get_properties().limits.minUniformBufferOffsetAlignment;
+        _uniform_buffer = std::make_shared<vulkan::core::ring_buffer>(_memory_allocator,
+                                                                      _logical_device,
+                                                                      VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                                                                      uniform_alignment,
+                                                                      UNIFORM_REGION_SIZE,
+                                                                      static_cast<uint32_t>(_swapchain->get_vk_images().size()));
+    }
 
-        for (size_t i = 0; i < _swapchain->get_vk_images().size(); ++i)
+    void vulkan_engine::create_swapchain(uint32_t width, uint32_t height, VkSwapchainKHR old_swapchain)
+    {
+        auto sharing_mode = _settings.is_concurrent_swapchain_sharing_enabled ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE;
+        _swapchain = std::make_shared<vulkan::core::swapchain>(_physical_device,
+                                                               _logical_device,
+                                                               _memory_allocator,
+                                                               _surface,
+                                                               _render_pass,
+                                                               width,
+                                                               height,
+                                                               _settings.presentation_mode,
+                                                               _settings.swapchain_images_count,
+                                                               sharing_mode,
+                                                               old_swapchain);
+    }
+
+    void vulkan_engine::enable_descriptor_binding_extensions(std::vector<const char*>& extensions)
+    {
+        // both extensions are enabled whenever the device has them so every binding mode can be measured, whichever one renders
+        bool is_vulkan_1_1 = _instance->get_api_version() >= VK_API_VERSION_1_1 &&
+                             _physical_device->get_properties().apiVersion >= VK_API_VERSION_1_1;
+        _is_update_template_supported = is_vulkan_1_1;
+        if (!is_vulkan_1_1 && _physical_device->supports_extension(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME))
+        {
+            extensions.push_back(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME);
+            _is_update_template_supported = true;
+        }
+
+        // push descriptors depend on physical device properties 2, which is core since vulkan 1.1
+        bool is_properties2_enabled =
+            is_vulkan_1_1 || _instance->is_extension_enabled(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+        _is_push_descriptor_supported =
+            is_properties2_enabled && _physical_device->supports_extension(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+        if (_is_push_descriptor_supported)
+            extensions.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+
+        _descriptor_binding_mode = _settings.binding_mode;
+        if (!is_descriptor_binding_mode_supported(_descriptor_binding_mode))
+            _descriptor_binding_mode = descriptor_binding_mode::update_templates;
+        if (!is_descriptor_binding_mode_supported(_descriptor_binding_mode))
+            _descriptor_binding_mode = descriptor_binding_mode::descriptor_sets;
+    }
+
+    bool vulkan_engine::is_descriptor_binding_mode_supported(descriptor_binding_mode binding_mode) const
+    {
+        switch (binding_mode)
         {
-            _uniform_buffers[i] =
-                std::make_shared<vulkan::core::buffer>(_physical_device,
-                                                       _logical_device,
-                                                       VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-                                                       VK_SHARING_MODE_EXCLUSIVE,
-                                                       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                                                       buffer_size);
+        case descriptor_binding_mode::update_templates:
+            return _is_update_template_supported;
+        case descriptor_binding_mode::push_descriptors:
+            return _is_push_descriptor_supported;
+        default:
+            return true;
         }
     }
 
-    void vulkan_engine::create_swapchain(uint32_t width, uint32_t height)
+    void vulkan_engine::create_descriptor_allocator()
     {
-        _swapchain = std::make_shared<vulkan::core::swapchain>(_physical_device, _logical_device, _surface, _render_pass, width, height);
+        // material sets live until the resources they reference are rebuilt, so their pools free sets individually
+        _descriptor_allocator = std::make_shared<vulkan::core::descriptor_allocator>(
+            _logical_device, DESCRIPTOR_POOL_RATIOS, VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT);
     }
 
-    void vulkan_engine::create_descriptor_pool()
+    void vulkan_engine::create_descriptor_binding()
     {
-        _descriptor_pool = std::make_shared<vulkan::core::descriptor_pool>(_logical_device, _swapchain->get_vk_images().size());
+        if (_descriptor_binding_mode == descriptor_binding_mode::push_descriptors)
+            _push_descriptors = std::make_shared<vulkan::core::push_descriptors>(
+                _logical_device, _descriptor_set_layout, _pipeline_layout, _is_update_template_supported);
+        else if (_descriptor_binding_mode == descriptor_binding_mode::update_templates)
+            _descriptor_update_template =
+                std::make_shared<vulkan::core::descriptor_update_template>(_logical_device, *_descriptor_set_layout);
+    }
+
+    void vulkan_engine::create_bindless_resources()
+    {
+        // the tables cannot outgrow what a single stage may read through update after bind sets
+        auto indexing_properties = _physical_device->get_descriptor_indexing_properties();
+        auto max_textures = std::min(BINDLESS_MAX_TEXTURES, indexing_properties.maxPerStageDescriptorUpdateAfterBindSampledImages);
+        auto max_storage_buffers =
+            std::min(BINDLESS_MAX_STORAGE_BUFFERS, indexing_properties.maxPerStageDescriptorUpdateAfterBindStorageBuffers);
+        _bindless_table = std::make_shared<vulkan::core::bindless_table>(
+            _logical_device, _samplers.get(_texture_sampler), max_textures, max_storage_buffers);
+
+        // the material table is always the first storage buffer of the table
+        _material_buffer = std::make_shared<vulkan::core::buffer>(_memory_allocator,
+                                                                  _logical_device,
+                                                                  vulkan::core::memory_category::other,
+                                                                  VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                                                  VK_SHARING_MODE_EXCLUSIVE,
+                                                                  VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                                  BINDLESS_MAX_MATERIALS * sizeof(vulkan::core::bindless_material));
+        _bindless_table->add_storage_buffer(*_material_buffer);
+
+        auto texture_index = _bindless_table->add_texture(_image_views.get(_texture_image_view));
+
+        _materials.clear();
+        _mesh_materials.clear();
+        for (size_t i = 0; i < _meshes.size(); ++i)
+        {
+            vulkan::core::bindless_material material;
+            material.texture_index = texture_index;
+
+            _mesh_materials.push_back(static_cast<uint32_t>(_materials.size()));
+            _materials.push_back(material);
+        }
+
+        _upload_context->copy_buffer(*_material_buffer, _materials.data(), _materials.size() * sizeof(vulkan::core::bindless_material));
     }
 
     void vulkan_engine::create_render_pass()
@@ -243,61 +469,145 @@ namespace owl
                                                                    _physical_device->get_max_usable_sample_count());
     }
 
-    void vulkan_engine::create_command_buffers(uint32_t indices_size)
+    void vulkan_engine::create_pipeline_layout()
+    {
+        if (_bindless_table == nullptr)
+        {
+            _pipeline_layout = std::make_shared<vulkan::core::pipeline_layout>(_logical_device, _descriptor_set_layout);
+            return;
+        }
+
+        VkPushConstantRange draw_constants_range{};
+        draw_constants_range.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        draw_constants_range.offset = 0;
+        draw_constants_range.size = sizeof(vulkan::core::bindless_draw_constants);
+
+        _pipeline_layout = std::make_shared<vulkan::core::pipeline_layout>(_logical_device,
+                                                                           _descriptor_set_layout,
+                                                                           std::vector{_bindless_table->get_vk_descriptor_set_layout()},
+                                                                           std::vector{draw_constants_range});
+    }
+
+    void vulkan_engine::create_graphics_pipeline()
+    {
+        auto fragment_shader_file =
+            _bindless_table != nullptr ? "../build/shaders/bindless_frag.spv" : "../build/shaders/passthrough_frag.spv";
+        _graphics_pipeline = std::make_shared<vulkan::core::graphics_pipeline>(fragment_shader_file,
+                                                                               "../build/shaders/passthrough_vert.spv",
+                                                                               _logical_device,
+                                                                               _swapchain,
+                                                                               _pipeline_layout,
+                                                                               _render_pass,
+                                                                               _physical_device->get_max_usable_sample_count());
+    }
+
+    void vulkan_engine::create_command_buffers()
     {
         _command_buffers =
             std::make_shared<vulkan::core::command_buffers>(_logical_device, _command_pool, _swapchain->get_framebuffers().size());
-        _command_buffers->process_command_buffers(0, [this, indices_size](const VkCommandBuffer& vk_command_buffer, size_t index) {
+        auto draw_bindings = get_draw_bindings();
+        _command_buffers->process_command_buffers(0, [this, &draw_bindings](const VkCommandBuffer& vk_command_buffer, size_t index) {
             vulkan::core::process_engine_command_buffer(vk_command_buffer,
                                                         index,
                                                         _graphics_pipeline,
                                                         _render_pass,
                                                         _swapchain,
-                                                        _vertex_buffer,
-                                                        _index_buffer,
+                                                        _geometry_pool,
+                                                        _meshes,
                                                         _descriptor_sets,
-                                                        _pipeline_layout,
-                                                        indices_size);
+                                                        _push_descriptors,
+                                                        draw_bindings,
+                                                        _bindless_table,
+                                                        _mesh_materials,
+                                                        _uniform_buffer,
+                                                        _pipeline_layout);
+            if (_swapchain->requires_ownership_transfer())
+                _swapchain->release_image_to_presentation(vk_command_buffer, index);
         });
     }
 
+    void vulkan_engine::create_presentation_command_buffers()
+    {
+        if (!_swapchain->requires_ownership_transfer())
+        {
+            _presentation_command_buffers = nullptr;
+            return;
+        }
+
+        // the graphics queue does not take ownership back, the render pass discards the image contents when it reacquires it
+        _presentation_command_buffers = std::make_shared<vulkan::core::command_buffers>(
+            _logical_device, _presentation_command_pool, _swapchain->get_vk_images().size());
+        _presentation_command_buffers->process_command_buffers(
+            VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT, [this](const VkCommandBuffer& vk_command_buffer, size_t index) {
+                _swapchain->acquire_image_for_presentation(vk_command_buffer, index);
+            });
+    }
+
     void vulkan_engine::create_descriptor_sets()
     {
+        // pushed bindings are recorded in the command buffers, there is no set to allocate
+        if (_push_descriptors != nullptr)
+            return;
+
         _descriptor_sets = std::make_shared<vulkan::core::descriptor_sets>(_logical_device,
                                                                            _descriptor_set_layout,
-                                                                           _descriptor_pool,
-                                                                           _uniform_buffers,
-                                                                           _texture_image_view,
-                                                                           _texture_sampler,
-                                                                           _swapchain->get_vk_images().size());
+                                                                           _descriptor_update_template,
+                                                                           *_descriptor_allocator,
+                                                                           get_draw_bindings(),
+                                                                           _swapchain->get_vk_images().size(),
+                                                                           _frame_arena.get());
     }
 
     void vulkan_engine::create_synchronization_objects()
     {
-        _image_available_semaphores.reserve(MAX_FRAMES_IN_FLIGHT);
-        _render_finished_semaphores.reserve(MAX_FRAMES_IN_FLIGHT);
-
-        _in_flight_fences.reserve(MAX_FRAMES_IN_FLIGHT);
-        _in_flight_images.resize(_swapchain->get_vk_images().size(), nullptr);
-
-        for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+        _image_available_semaphores.clear();
+        _render_finished_semaphores.clear();
+        _ownership_released_semaphores.clear();
+        _image_available_semaphores.reserve(_settings.frames_in_flight);
+        _render_finished_semaphores.reserve(_settings.frames_in_flight);
+        _ownership_released_semaphores.reserve(_settings.frames_in_flight);
+
+        _in_flight_frame_values.assign(_settings.frames_in_flight, _graphics_timeline->get_submitted_value());
+        _in_flight_image_values.resize(_swapchain->get_vk_images().size(), 0);
+        _latency_tracker.reset(_settings.frames_in_flight);
+
+        for (uint32_t i = 0; i < _settings.frames_in_flight; ++i)
         {
             _image_available_semaphores.push_back(std::make_shared<vulkan::core::semaphore>(_logical_device));
             _render_finished_semaphores.push_back(std::make_shared<vulkan::core::semaphore>(_logical_device));
-
-            _in_flight_fences.push_back(std::make_shared<vulkan::core::fence>(_logical_device));
+            _ownership_released_semaphores.push_back(std::make_shared<vulkan::core::semaphore>(_logical_device));
         }
     }
 
+    void vulkan_engine::create_submission_services()
+    {
+        // queue families may hand out the same VkQueue for several roles, each VkQueue gets exactly one service
+        const auto& graphics_queue = _logical_device->get_vk_graphics_queue();
+        _graphics_submissions = std::make_shared<vulkan::core::submission_service>(_logical_device, graphics_queue);
+        _graphics_timeline = _graphics_submissions->get_timeline();
+
+        const auto& presentation_queue = _logical_device->get_vk_presentation_queue();
+        _presentation_submissions = presentation_queue == _graphics_submissions->get_vk_queue()
+                                        ? _graphics_submissions
+                                        : std::make_shared<vulkan::core::submission_service>(_logical_device, presentation_queue);
+
+        const auto& transfer_queue = _logical_device->get_vk_transfer_queue();
+        if (transfer_queue == _graphics_submissions->get_vk_queue())
+            _transfer_submissions = _graphics_submissions;
+        else if (transfer_queue == _presentation_submissions->get_vk_queue())
+            _transfer_submissions = _presentation_submissions;
+        else
+            _transfer_submissions = std::make_shared<vulkan::core::submission_service>(_logical_device, transfer_queue);
+    }
+
     void vulkan_engine::create_texture_resources(texture&& texture)
     {
         _mip_levels = static_cast<uint32_t>(std::floor(std::log2(std::max(texture.width, texture.height))));
         VkDeviceSize image_size = texture.width * texture.height * 4;
 
-        auto staging_buffer = vulkan::core::create_staging_buffer(texture.data.data(), _physical_device, _logical_device, image_size);
-
-        _texture_image = std::make_shared<vulkan::core::image>(_physical_device,
+        _texture_image = std::make_shared<vulkan::core::image>(_memory_allocator,
                                                                _logical_device,
+                                                               vulkan::core::memory_category::texture,
                                                                static_cast<uint32_t>(texture.width),
                                                                static_cast<uint32_t>(texture.height),
                                                                _mip_levels,
@@ -308,57 +618,394 @@ namespace owl
                                                                    VK_IMAGE_USAGE_SAMPLED_BIT,
                                                                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-        _texture_image->transition_layout(_command_pool, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-        _texture_image->copy_buffer(_command_pool, staging_buffer->get_vk_handle());
+        _upload_context->transition_layout(*_texture_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+        _upload_context->copy_image(*_texture_image, texture.data.data(), image_size);
 
         if (_physical_device->supports_linear_filtering(_texture_image->get_format()))
-            _texture_image->generate_mipmaps(_command_pool);
+            _upload_context->generate_mipmaps(*_texture_image);
+        else
+            _upload_context->transition_layout(*_texture_image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 
-        _texture_image_view = std::make_shared<vulkan::core::image_view>(_logical_device,
-                                                                         _texture_image->get_vk_handle(),
-                                                                         _mip_levels,
-                                                                         _texture_image->get_format(),
-                                                                         VK_IMAGE_ASPECT_COLOR_BIT);
+        _texture_image_view = _image_views.create(
+            _logical_device, _texture_image->get_vk_handle(), _mip_levels, _texture_image->get_format(), VK_IMAGE_ASPECT_COLOR_BIT);
 
-        _texture_sampler = std::make_shared<vulkan::core::sampler>(_logical_device, _mip_levels);
+        _texture_sampler = _samplers.create(_logical_device, _mip_levels);
     }
 
-    void vulkan_engine::recreate_swapchain(uint32_t width, uint32_t height)
+    void vulkan_engine::register_movable_resources()
     {
-        _logical_device->wait_idle();
-        clean_swapchain();
+        auto on_moved = [this]() { _resources_moved = true; };
+
+        _defragmenter->register_buffer(_geometry_pool->get_vertex_buffer(), on_moved);
+        _defragmenter->register_buffer(_geometry_pool->get_index_buffer(), on_moved);
+        // bindless slots may be read by frames in flight and are never rewritten, so a bindless texture stays where it is
+        if (_bindless_table == nullptr)
+            _defragmenter->register_image(_texture_image, on_moved);
+    }
+
+    void vulkan_engine::compact_geometry()
+    {
+        // a defragmentation move may be copying the pool's buffers in the same upload batch
+        if (_defragmenter->is_moving() || !_geometry_pool->is_fragmented())
+            return;
+
+        // the command buffers recorded so far draw from the old offsets, the next frame records them again
+        if (_geometry_pool->compact().has_value())
+            _resources_moved = true;
+    }
+
+    void vulkan_engine::rebuild_moved_resources()
+    {
+        // recorded command buffers and descriptor sets still reference the handles the defragmenter retired, and may still be in
+        // flight, so they are released by the deletion queue instead of waiting for the device
+        _resources_moved = false;
+
+        _deletion_queue->retire(_command_buffers);
+        _deletion_queue->retire(_descriptor_sets);
+
+        // a bindless texture is never moved, and its slot keeps pointing at the current view
+        if (_bindless_table == nullptr)
+        {
+            _deletion_queue->enqueue([this, image_view = _texture_image_view]() { _image_views.destroy(image_view); });
+            _texture_image_view = _image_views.create(
+                _logical_device, _texture_image->get_vk_handle(), _mip_levels, _texture_image->get_format(), VK_IMAGE_ASPECT_COLOR_BIT);
+        }
 
-        create_swapchain(width, height);
-        create_render_pass();
-        _swapchain->create_framebuffers(_render_pass);
-        create_uniform_buffers();
-        create_descriptor_pool();
         create_descriptor_sets();
-        create_command_buffers(_indices_size);
+        create_command_buffers();
     }
 
-    void vulkan_engine::clean_swapchain()
+    void vulkan_engine::recreate_swapchain(uint32_t width, uint32_t height)
     {
-        _command_buffers = nullptr;
-        _render_pass = nullptr;
-        _swapchain = nullptr;
-        _uniform_buffers.clear();
-        _descriptor_pool = nullptr;
+        auto start_time = std::chrono::steady_clock::now();
+        auto host_allocations_count = _host_allocator->get_report().get_total().allocations_count;
+
+        // the new swapchain brings its own extent dependent attachments and framebuffers, everything else is only rebuilt when
+        // the image format or count it depends on changed; viewport and scissor are dynamic so the pipeline survives a resize
+        auto old_swapchain = _swapchain;
+        auto old_format = old_swapchain->get_vk_image_format();
+        create_swapchain(width, height, old_swapchain->get_vk_handle());
+        _deletion_queue->retire(old_swapchain);
+
+        if (_swapchain->get_vk_image_format() != old_format)
+        {
+            _deletion_queue->retire(_graphics_pipeline);
+            _deletion_queue->retire(_render_pass);
+            create_render_pass();
+            create_graphics_pipeline();
+        }
+
+        _swapchain->create_framebuffers(_render_pass);
+
+        if (_swapchain->get_vk_images().size() != _in_flight_image_values.size())
+        {
+            _deletion_queue->retire(_uniform_buffer);
+            _deletion_queue->retire(_descriptor_sets);
+            create_uniform_buffers();
+            create_descriptor_sets();
+
+            // only a new ring starts with regions no frame has used, a reused one keeps the values since frames of the old
+            // swapchain may still read its regions
+            _in_flight_image_values.assign(_swapchain->get_vk_images().size(), 0);
+        }
+
+        // recorded command buffers reference the old framebuffers and may still be in flight
+        _deletion_queue->retire(_command_buffers);
+        create_command_buffers();
+
+        // the deletion queue only tracks the graphics queue, the acquire batches on the presentation queue are waited on instead
+        if (_presentation_command_buffers != nullptr)
+        {
+            const auto& presentation_timeline = _presentation_submissions->get_timeline();
+            presentation_timeline->wait(presentation_timeline->get_submitted_value());
+        }
+        create_presentation_command_buffers();
+
+        _swapchain_recreation_host_allocations_count = _host_allocator->get_report().get_total().allocations_count - host_allocations_count;
+        record_swapchain_recreation(std::chrono::steady_clock::now() - start_time);
     }
 
-    void vulkan_engine::update_uniform_buffers(uint32_t current_image)
+    void vulkan_engine::record_swapchain_recreation(std::chrono::steady_clock::duration duration)
     {
-        static auto start_time = std::chrono::high_resolution_clock::now();
-        auto current_time = std::chrono::high_resolution_clock::now();
-        float time = std::chrono::duration<float, std::chrono::seconds::period>(current_time - start_time).count();
+        auto duration_us = std::chrono::duration_cast<std::chrono::microseconds>(duration);
 
+        _swapchain_recreation_statistics.recreations_count++;
+        _swapchain_recreation_statistics.last_duration = duration_us;
+        _swapchain_recreation_statistics.max_duration = std::max(_swapchain_recreation_statistics.max_duration, duration_us);
+        _swapchain_recreation_statistics.total_duration += duration_us;
+    }
+
+    void vulkan_engine::update_uniform_buffers(uint32_t current_image, const frame_state& state)
+    {
+        // the projection depends on the swapchain extent, which only the render side knows
         auto extent = _swapchain->get_vk_extent();
         vulkan::model_view_projection mvp;
-        mvp.model = glm::rotate(glm::mat4(1.0f), time * glm::radians(45.0f), glm::vec3(0.0f, 0.0f, 1.0f));
-        mvp.view = glm::lookAt(glm::vec3(2.0f, 2.0f, 2.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+        mvp.model = state.model;
+        mvp.view = state.view;
         mvp.projection = glm::perspective(glm::radians(45.0f), extent.width / (float)extent.height, 0.1f, 10.0f);
         mvp.projection[1][1] *= -1; // in vulkan Y coordinate is inverted (compared to openGL)
 
-        vulkan::core::copy_memory(&mvp, _logical_device, *_uniform_buffers[current_image], sizeof(mvp));
+        _uniform_buffer->begin_region(current_image);
+        _uniform_buffer->push(mvp);
+    }
+
+    void vulkan_engine::write_memory_report()
+    {
+        std::ofstream report_file(_memory_report_path, std::ios::trunc);
+        report_file << _memory_tracker->get_report().to_json() << std::endl;
+    }
+
+    vulkan::core::object_bindings vulkan_engine::get_draw_bindings() const
+    {
+        vulkan::core::object_bindings bindings;
+        bindings.uniform_buffer.buffer = _uniform_buffer->get_vk_handle();
+        bindings.uniform_buffer.offset = 0;
+        bindings.uniform_buffer.range = sizeof(vulkan::model_view_projection);
+        bindings.texture.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        bindings.texture.imageView = _image_views.get(_texture_image_view).get_vk_handle();
+        bindings.texture.sampler = _samplers.get(_texture_sampler).get_vk_handle();
+
+        return bindings;
+    }
+
+    std::chrono::nanoseconds vulkan_engine::measure_descriptor_update_cost(descriptor_binding_mode binding_mode, uint32_t draws_count)
+    {
+        if (!is_descriptor_binding_mode_supported(binding_mode))
+            throw std::invalid_argument("Unsupported descriptor binding mode: " + to_string(binding_mode));
+
+        // the layouts the engine renders with only fit the mode it was initialized with, the benchmark builds its own
+        bool is_push_descriptor = binding_mode == descriptor_binding_mode::push_descriptors;
+        auto layout = std::make_shared<vulkan::core::descriptor_set_layout>(_logical_device, is_push_descriptor);
+        auto pipeline_layout = std::make_shared<vulkan::core::pipeline_layout>(_logical_device, layout);
+        auto bindings = get_draw_bindings();
+
+        // each mode runs once to warm up pools and command buffer storage, only the second run is timed
+        std::chrono::steady_clock::duration duration{0};
+        if (is_push_descriptor)
+        {
+            vulkan::core::push_descriptors push_descriptors(_logical_device, layout, pipeline_layout, _is_update_template_supported);
+            vulkan::core::command_buffers command_buffers(_logical_device, _command_pool, 1);
+            const auto& vk_command_buffer = command_buffers.get_vk_command_buffers()[0];
+
+            // the command buffer is never submitted, it is freed while still recording
+            command_buffers.begin(0, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+            for (int run = 0; run < 2; ++run)
+            {
+                auto start_time = std::chrono::steady_clock::now();
+                for (uint32_t i = 0; i < draws_count; ++i)
+                    push_descriptors.push(vk_command_buffer, bindings);
+                duration = std::chrono::steady_clock::now() - start_time;
+            }
+            command_buffers.end(0);
+        }
+        else
+        {
+            std::shared_ptr<vulkan::core::descriptor_update_template> update_template;
+            if (binding_mode == descriptor_binding_mode::update_templates)
+                update_template = std::make_shared<vulkan::core::descriptor_update_template>(_logical_device, *layout);
+
+            // a per draw consumer of sets allocates them from a transient pool that is reset wholesale
+            vulkan::core::descriptor_allocator allocator(_logical_device, DESCRIPTOR_POOL_RATIOS, 0, draws_count);
+            for (int run = 0; run < 2; ++run)
+            {
+                allocator.reset();
+                auto start_time = std::chrono::steady_clock::now();
+                for (uint32_t i = 0; i < draws_count; ++i)
+                {
+                    auto vk_descriptor_set = allocator.allocate(*layout).vk_descriptor_set;
+                    if (update_template != nullptr)
+                        update_template->update(vk_descriptor_set, bindings);
+                    else
+                    {
+                        auto descriptor_writes = layout->create_writes(vk_descriptor_set, bindings);
+                        vkUpdateDescriptorSets(_logical_device->get_vk_handle(),
+                                               static_cast<uint32_t>(descriptor_writes.size()),
+                                               descriptor_writes.data(),
+                                               0,
+                                               nullptr);
+                    }
+                }
+                duration = std::chrono::steady_clock::now() - start_time;
+            }
+        }
+
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(duration) / std::max(draws_count, 1u);
+    }
+
+    allocation_benchmark_result vulkan_engine::measure_allocation_throughput(uint32_t allocations_count)
+    {
+        // once the live set is full every allocation first frees a random one, which is what fragments the blocks
+        const size_t max_live_allocations_count = 2048;
+        const VkDeviceSize min_allocation_size = 1024;
+        const VkDeviceSize max_allocation_size = 256 * 1024;
+        const VkDeviceSize allocation_alignment = 256;
+
+        auto memory_allocator = std::make_shared<vulkan::core::memory_allocator>(_physical_device, _logical_device, _memory_tracker);
+
+        std::mt19937 random_engine(allocations_count);
+        std::uniform_int_distribution<VkDeviceSize> size_distribution(min_allocation_size, max_allocation_size);
+        std::vector<vulkan::core::memory_allocation> allocations;
+        allocations.reserve(max_live_allocations_count);
+
+        std::chrono::steady_clock::duration allocation_duration{0};
+        std::chrono::steady_clock::duration free_duration{0};
+        uint32_t frees_count = 0;
+
+        for (uint32_t i = 0; i < allocations_count; ++i)
+        {
+            if (allocations.size() == max_live_allocations_count)
+            {
+                std::uniform_int_distribution<size_t> index_distribution(0, allocations.size() - 1);
+                std::swap(allocations[index_distribution(random_engine)], allocations.back());
+
+                auto start_time = std::chrono::steady_clock::now();
+                memory_allocator->free(allocations.back());
+                free_duration += std::chrono::steady_clock::now() - start_time;
+
+                allocations.pop_back();
+                frees_count++;
+            }
+
+            // buffers and images alternate, so neighbouring ranges also have to respect bufferImageGranularity
+            VkMemoryRequirements memory_requirements{size_distribution(random_engine), allocation_alignment, ~0u};
+            auto tiling = i % 2 == 0 ? vulkan::core::resource_tiling::linear : vulkan::core::resource_tiling::optimal;
+
+            auto start_time = std::chrono::steady_clock::now();
+            allocations.push_back(memory_allocator->allocate(
+                memory_requirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, tiling, vulkan::core::memory_category::other));
+            allocation_duration += std::chrono::steady_clock::now() - start_time;
+        }
+
+        allocation_benchmark_result result{};
+        result.statistics = memory_allocator->get_statistics();
+        result.allocation_cost =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(allocation_duration) / std::max(allocations_count, 1u);
+        result.free_cost = std::chrono::duration_cast<std::chrono::nanoseconds>(free_duration) / std::max(frees_count, 1u);
+
+        for (const auto& allocation : allocations)
+            memory_allocator->free(allocation);
+
+        // the same sizes with one device allocation each, freed right away so maxMemoryAllocationCount is never reached
+        auto memory_type_index = vulkan::core::device_memory::find_memory_type(_physical_device, ~0u, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        random_engine.seed(allocations_count);
+
+        std::chrono::steady_clock::duration device_allocation_duration{0};
+        for (uint32_t i = 0; i < allocations_count; ++i)
+        {
+            auto start_time = std::chrono::steady_clock::now();
+            vulkan::core::device_memory device_memory(_logical_device, memory_type_index, size_distribution(random_engine));
+            device_allocation_duration += std::chrono::steady_clock::now() - start_time;
+        }
+
+        result.device_allocation_cost =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(device_allocation_duration) / std::max(allocations_count, 1u);
+
+        return result;
+    }
+
+    std::chrono::nanoseconds vulkan_engine::measure_upload_cost(bool is_direct_write_allowed,
+                                                                uint32_t uploads_count,
+                                                                VkDeviceSize upload_size)
+    {
+        std::vector<char> values(static_cast<size_t>(upload_size), 1);
+
+        auto start_time = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < uploads_count; ++i)
+        {
+            auto buffer = vulkan::core::create_device_local_buffer(values.data(),
+                                                                   _memory_allocator,
+                                                                   _logical_device,
+                                                                   *_upload_context,
+                                                                   vulkan::core::memory_category::mesh,
+                                                                   VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                                                   upload_size,
+                                                                   is_direct_write_allowed);
+
+            // a direct write has nothing to submit, the token is then the one of the last upload and already complete
+            _upload_context->submit().wait();
+        }
+        auto duration = std::chrono::steady_clock::now() - start_time;
+
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(duration) / std::max(uploads_count, 1u);
+    }
+
+    std::vector<defragmentation_soak_sample> vulkan_engine::run_defragmentation_soak(uint32_t frames_count, uint32_t samples_count)
+    {
+        // small blocks make the resident set span many of them, so unloads leave holes quickly
+        const VkDeviceSize soak_block_size = 4 * 1024 * 1024;
+        const size_t resident_buffers_count = 256;
+        const size_t reloads_per_frame_count = 4;
+        const VkDeviceSize min_buffer_size = 16 * 1024;
+        const VkDeviceSize max_buffer_size = 512 * 1024;
+
+        // the soak owns its allocator and deletion queue so that the scene's memory does not blur the samples
+        auto memory_allocator =
+            std::make_shared<vulkan::core::memory_allocator>(_physical_device, _logical_device, _memory_tracker, soak_block_size);
+        auto deletion_queue = std::make_shared<vulkan::core::deletion_queue>();
+        vulkan::core::defragmenter defragmenter(memory_allocator, _upload_context, deletion_queue);
+
+        std::mt19937 random_engine(frames_count);
+        std::uniform_int_distribution<VkDeviceSize> size_distribution(min_buffer_size, max_buffer_size);
+        std::vector<std::shared_ptr<vulkan::core::buffer>> buffers;
+
+        auto load_buffer = [&]()
+        {
+            auto buffer = std::make_shared<vulkan::core::buffer>(memory_allocator,
+                                                                 _logical_device,
+                                                                 vulkan::core::memory_category::mesh,
+                                                                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                                                 VK_SHARING_MODE_EXCLUSIVE,
+                                                                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                                 size_distribution(random_engine));
+            defragmenter.register_buffer(buffer, nullptr);
+            buffers.push_back(std::move(buffer));
+        };
+
+        while (buffers.size() < resident_buffers_count)
+            load_buffer();
+
+        std::vector<defragmentation_soak_sample> samples;
+        uint32_t sample_interval = std::max(frames_count / std::max(samples_count, 1u), 1u);
+
+        for (uint32_t frame = 1; frame <= frames_count; ++frame)
+        {
+            deletion_queue->set_submitted_value(frame);
+
+            for (size_t i = 0; i < reloads_per_frame_count; ++i)
+            {
+                std::uniform_int_distribution<size_t> index_distribution(0, buffers.size() - 1);
+                std::swap(buffers[index_distribution(random_engine)], buffers.back());
+                deletion_queue->retire(buffers.back());
+                buffers.pop_back();
+                load_buffer();
+            }
+
+            defragmenter.step(DEFRAGMENTATION_TIME_BUDGET, DEFRAGMENTATION_SIZE_BUDGET);
+
+            // waiting on the copies stands in for the frame fence, everything retired so far is then unused
+            _upload_context->submit().wait();
+            deletion_queue->collect(frame);
+
+            if (frame % sample_interval == 0 || frame == frames_count)
+            {
+                auto memory_statistics = memory_allocator->get_statistics();
+                auto defragmentation_statistics = defragmenter.get_statistics();
+
+                defragmentation_soak_sample sample{};
+                sample.frame = frame;
+                sample.used_size = memory_statistics.used_size;
+                sample.reserved_size = memory_statistics.reserved_size;
+                sample.blocks_count = memory_statistics.blocks_count;
+                sample.fragmentation = memory_statistics.fragmentation;
+                sample.moves_count = defragmentation_statistics.moves_count;
+                samples.push_back(sample);
+            }
+        }
+
+        // the last copies were waited on, buffers still holding a retired copy release it when destroyed
+        buffers.clear();
+        deletion_queue->flush();
+
+        return samples;
     }
-} // namespace owl
+} // namespace owl
\ No newline at end of file
@@ -1,39 +1,99 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <ostream>
 #include <string>
 #include <vector>
 
+#include <core/bindless_table.h>
 #include <core/buffer.h>
 #include <core/command_buffers.h>
 #include <core/command_pool.h>
 #include <core/debug_messenger.h>
-#include <core/descriptor_pool.h>
+#include <core/defragmenter.h>
+#include <core/deletion_queue.h>
+#include <core/descriptor_allocator.h>
 #include <core/descriptor_set_layout.h>
 #include <core/descriptor_sets.h>
-#include <core/fence.h>
+#include <core/descriptor_update_template.h>
+#include <core/frame_arena.h>
 #include <core/framebuffer.h>
+#include <core/geometry_pool.h>
 #include <core/graphics_pipeline.h>
+#include <core/host_allocator.h>
 #include <core/image.h>
 #include <core/image_view.h>
 #include <core/instance.h>
 #include <core/logical_device.h>
+#include <core/memory_allocator.h>
+#include <core/memory_tracker.h>
+#include <core/object_bindings.h>
 #include <core/physical_device.h>
 #include <core/pipeline_layout.h>
+#include <core/push_descriptors.h>
+#include <core/queue_timeline.h>
 #include <core/render_pass.h>
+#include <core/resource_pool.h>
+#include <core/ring_buffer.h>
 #include <core/sampler.h>
 #include <core/semaphore.h>
+#include <core/staging_belt.h>
+#include <core/submission_service.h>
 #include <core/surface.h>
 #include <core/swapchain.h>
+#include <core/upload_context.h>
+#include <engine_settings.h>
+#include <frame_state.h>
+#include <latency_tracker.h>
 #include <mesh.h>
 #include <texture.h>
 
 namespace owl
 {
+    struct swapchain_recreation_statistics
+    {
+        size_t recreations_count = 0;
+        std::chrono::microseconds last_duration{0};
+        std::chrono::microseconds max_duration{0};
+        std::chrono::microseconds total_duration{0};
+    };
+
+    struct allocation_benchmark_result
+    {
+        std::chrono::nanoseconds allocation_cost{0};
+        std::chrono::nanoseconds free_cost{0};
+        std::chrono::nanoseconds device_allocation_cost{0};
+        vulkan::core::memory_statistics statistics;
+    };
+
+    struct defragmentation_soak_sample
+    {
+        uint32_t frame = 0;
+        VkDeviceSize used_size = 0;
+        VkDeviceSize reserved_size = 0;
+        size_t blocks_count = 0;
+        float fragmentation = 0.0f;
+        size_t moves_count = 0;
+    };
+
     class vulkan_engine
     {
     public:
-        const int MAX_FRAMES_IN_FLIGHT = 2;
+        const VkDeviceSize UNIFORM_REGION_SIZE = 256 * 1024;
+        const VkDeviceSize STAGING_BELT_BUDGET = 32 * 1024 * 1024;
+        const uint32_t GEOMETRY_POOL_VERTICES_CAPACITY = 1024 * 1024;
+        const uint32_t GEOMETRY_POOL_INDICES_CAPACITY = 4 * 1024 * 1024;
+        const std::chrono::microseconds DEFRAGMENTATION_TIME_BUDGET{500};
+        const VkDeviceSize DEFRAGMENTATION_SIZE_BUDGET = 8 * 1024 * 1024;
+        const uint32_t BINDLESS_MAX_TEXTURES = 16 * 1024;
+        const uint32_t BINDLESS_MAX_STORAGE_BUFFERS = 256;
+        const uint32_t BINDLESS_MAX_MATERIALS = 4096;
+        const std::vector<vulkan::core::descriptor_pool_ratio> DESCRIPTOR_POOL_RATIOS = {
+            {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1.0f},
+            {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1.0f},
+            {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 2.0f}};
 
         const std::vector<const char*> validation_layers = {"VK_LAYER_KHRONOS_validation"};
         const std::vector<const char*> device_extensions = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
@@ -44,7 +104,7 @@ namespace owl
         const bool enable_validation_layers = true;
 #endif
 
-        vulkan_engine();
+        explicit vulkan_engine(const engine_settings& settings = engine_settings());
         ~vulkan_engine();
 
         const vulkan::core::instance& get_instance() { return *_instance; }
@@ -54,67 +114,150 @@ namespace owl
         void initialize(uint32_t width, uint32_t height, mesh&& mesh, texture&& texture);
 
         bool acquire_image();
-        bool draw_image();
+        bool draw_image(const frame_state_latch& latch_state);
         void recreate_swapchain(uint32_t width, uint32_t height);
 
         void wait_idle();
 
+        const engine_settings& get_settings() const { return _settings; }
+        void set_settings(const engine_settings& settings);
+        VkPresentModeKHR get_presentation_mode() const { return _swapchain->get_vk_presentation_mode(); }
+        latency_statistics get_latency_statistics() const { return _latency_tracker.get_statistics(); }
+        void write_frame_latencies(std::ostream& stream) const { _latency_tracker.write_frame_samples(stream); }
+
         void set_framebuffer_resized(bool is_resized) { _framebuffer_resized = is_resized; }
+        void set_memory_report_path(const std::string& path) { _memory_report_path = path; }
+
+        vulkan::core::memory_report get_memory_report() const { return _memory_tracker->get_report(); }
+        vulkan::core::defragmentation_statistics get_defragmentation_statistics() const { return _defragmenter->get_statistics(); }
+        vulkan::core::host_allocation_report get_host_allocation_report() const { return _host_allocator->get_report(); }
+        size_t get_swapchain_recreation_host_allocations_count() const { return _swapchain_recreation_host_allocations_count; }
+        swapchain_recreation_statistics get_swapchain_recreation_statistics() const { return _swapchain_recreation_statistics; }
+        size_t get_frame_heap_allocations_count() const { return _frame_heap_allocations_count; }
+        size_t get_pending_deletions_count() const { return _deletion_queue->get_size(); }
+        size_t get_descriptor_pools_count() const { return _descriptor_allocator->get_pools_count(); }
+        bool is_timeline_semaphore_enabled() const { return _graphics_timeline->is_timeline_semaphore(); }
+        const std::shared_ptr<vulkan::core::submission_service>& get_graphics_submissions() const { return _graphics_submissions; }
+        bool has_separate_presentation_family() const { return _presentation_command_pool != nullptr; }
+        VkSharingMode get_swapchain_sharing_mode() const { return _swapchain->get_vk_sharing_mode(); }
+        descriptor_binding_mode get_descriptor_binding_mode() const { return _descriptor_binding_mode; }
+        bool is_descriptor_binding_mode_supported(descriptor_binding_mode binding_mode) const;
+        bool is_bindless_enabled() const { return _bindless_table != nullptr; }
+        bool is_unified_memory() const { return _memory_allocator->is_unified_memory(); }
+
+        // cpu time to bind the resources of one draw with the given mode, set allocation included; nothing is submitted
+        std::chrono::nanoseconds measure_descriptor_update_cost(descriptor_binding_mode binding_mode, uint32_t draws_count);
+
+        // sub-allocates and frees random sizes with a bounded live set, against one vkAllocateMemory per allocation
+        allocation_benchmark_result measure_allocation_throughput(uint32_t allocations_count);
+        // time from creating a vertex buffer until its data is visible to the gpu, staged or written directly on unified memory
+        std::chrono::nanoseconds measure_upload_cost(bool is_direct_write_allowed, uint32_t uploads_count, VkDeviceSize upload_size);
+        // loads and unloads buffers of random sizes every frame while defragmenting, samples the allocator along the way
+        std::vector<defragmentation_soak_sample> run_defragmentation_soak(uint32_t frames_count, uint32_t samples_count);
 
     private:
+        engine_settings _settings;
+        latency_tracker _latency_tracker;
+        descriptor_binding_mode _descriptor_binding_mode = descriptor_binding_mode::descriptor_sets;
+        bool _is_update_template_supported = false;
+        bool _is_push_descriptor_supported = false;
+
+        std::shared_ptr<vulkan::core::host_allocator> _host_allocator;
         std::shared_ptr<vulkan::core::instance> _instance;
         std::shared_ptr<vulkan::core::surface> _surface;
         std::shared_ptr<vulkan::core::physical_device> _physical_device;
         std::shared_ptr<vulkan::core::logical_device> _logical_device;
+        std::shared_ptr<vulkan::core::memory_tracker> _memory_tracker;
+        std::shared_ptr<vulkan::core::memory_allocator> _memory_allocator;
+        std::shared_ptr<vulkan::core::frame_arena> _frame_arena;
+        std::shared_ptr<vulkan::core::submission_service> _graphics_submissions;
+        std::shared_ptr<vulkan::core::submission_service> _presentation_submissions;
+        std::shared_ptr<vulkan::core::submission_service> _transfer_submissions;
+        std::shared_ptr<vulkan::core::queue_timeline> _graphics_timeline;
+        std::shared_ptr<vulkan::core::deletion_queue> _deletion_queue;
 
         std::shared_ptr<vulkan::core::swapchain> _swapchain;
         std::shared_ptr<vulkan::core::render_pass> _render_pass;
         std::shared_ptr<vulkan::core::pipeline_layout> _pipeline_layout;
         std::shared_ptr<vulkan::core::graphics_pipeline> _graphics_pipeline;
         std::shared_ptr<vulkan::core::command_pool> _command_pool;
+        std::shared_ptr<vulkan::core::command_pool> _transfer_command_pool;
+        std::shared_ptr<vulkan::core::command_pool> _presentation_command_pool;
+        std::shared_ptr<vulkan::core::staging_belt> _staging_belt;
+        std::shared_ptr<vulkan::core::upload_context> _upload_context;
+        std::shared_ptr<vulkan::core::defragmenter> _defragmenter;
         std::shared_ptr<vulkan::core::command_buffers> _command_buffers;
+        std::shared_ptr<vulkan::core::command_buffers> _presentation_command_buffers;
         std::shared_ptr<vulkan::core::descriptor_set_layout> _descriptor_set_layout;
-        std::shared_ptr<vulkan::core::descriptor_pool> _descriptor_pool;
+        std::shared_ptr<vulkan::core::descriptor_allocator> _descriptor_allocator;
         std::shared_ptr<vulkan::core::descriptor_sets> _descriptor_sets;
+        std::shared_ptr<vulkan::core::descriptor_update_template> _descriptor_update_template;
+        std::shared_ptr<vulkan::core::push_descriptors> _push_descriptors;
+        std::shared_ptr<vulkan::core::bindless_table> _bindless_table;
+        std::shared_ptr<vulkan::core::buffer> _material_buffer;
+        std::vector<vulkan::core::bindless_material> _materials;
+        std::vector<uint32_t> _mesh_materials;
 
-        std::shared_ptr<vulkan::core::buffer> _vertex_buffer;
-        std::shared_ptr<vulkan::core::buffer> _index_buffer;
-        std::vector<std::shared_ptr<vulkan::core::buffer>> _uniform_buffers;
+        std::shared_ptr<vulkan::core::geometry_pool> _geometry_pool;
+        std::vector<vulkan::core::mesh_handle> _meshes;
+        std::shared_ptr<vulkan::core::ring_buffer> _uniform_buffer;
 
         std::vector<std::shared_ptr<vulkan::core::semaphore>> _image_available_semaphores;
         std::vector<std::shared_ptr<vulkan::core::semaphore>> _render_finished_semaphores;
+        std::vector<std::shared_ptr<vulkan::core::semaphore>> _ownership_released_semaphores;
 
-        std::vector<std::shared_ptr<vulkan::core::fence>> _in_flight_fences;
-        std::vector<std::shared_ptr<vulkan::core::fence>> _in_flight_images;
+        std::vector<uint64_t> _in_flight_frame_values;
+        std::vector<uint64_t> _in_flight_image_values;
 
         std::shared_ptr<vulkan::core::image> _texture_image;
-        std::shared_ptr<vulkan::core::image_view> _texture_image_view;
-        std::shared_ptr<vulkan::core::sampler> _texture_sampler;
+        vulkan::core::resource_pool<vulkan::core::image_view> _image_views;
+        vulkan::core::resource_pool<vulkan::core::sampler> _samplers;
+        vulkan::core::resource_handle<vulkan::core::image_view> _texture_image_view;
+        vulkan::core::resource_handle<vulkan::core::sampler> _texture_sampler;
 
         uint32_t _mip_levels;
 
         size_t _current_frame = 0;
         uint32_t _current_image_index = 0;
-        bool _framebuffer_resized = false;
+        std::atomic<bool> _framebuffer_resized{false};
+        bool _resources_moved = false;
 
-        uint32_t _indices_size = 0;
+        std::string _memory_report_path;
+        size_t _swapchain_recreation_host_allocations_count = 0;
+        swapchain_recreation_statistics _swapchain_recreation_statistics;
+        size_t _frame_heap_allocations_count = 0;
+        size_t _frame_start_heap_allocations_count = 0;
 
         void display_available_extensions();
 
         void create_buffers(mesh&& mesh);
         void create_uniform_buffers();
-        void create_swapchain(uint32_t width, uint32_t height);
-        void create_descriptor_pool();
+        void create_swapchain(uint32_t width, uint32_t height, VkSwapchainKHR old_swapchain = VK_NULL_HANDLE);
+        void enable_descriptor_binding_extensions(std::vector<const char*>& extensions);
+        void create_descriptor_allocator();
+        void create_descriptor_binding();
+        void create_bindless_resources();
         void create_render_pass();
-        void create_command_buffers(uint32_t indices_size);
+        void create_pipeline_layout();
+        void create_graphics_pipeline();
+        void create_command_buffers();
+        void create_presentation_command_buffers();
         void create_descriptor_sets();
         void create_synchronization_objects();
+        void create_submission_services();
         void create_texture_resources(texture&& texture);
+        void register_movable_resources();
+        void compact_geometry();
+        void rebuild_moved_resources();
 
-        void clean_swapchain();
+        void record_swapchain_recreation(std::chrono::steady_clock::duration duration);
 
         void run_internal();
+        void begin_frame();
+
+        void update_uniform_buffers(uint32_t current_image, const frame_state& state);
+        void write_memory_report();
 
-        void update_uniform_buffers(uint32_t current_image);
+        vulkan::core::object_bindings get_draw_bindings() const;
     };
 } // namespace owl
\ No newline at end of file
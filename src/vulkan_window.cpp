@@ -1,5 +1,9 @@
 #include "vulkan_window.h"
 
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
 #include <unordered_map>
 #include <vector>
 
@@ -11,8 +15,10 @@
 
 namespace owl
 {
-    vulkan_window::vulkan_window(const uint32_t width, const uint32_t height)
-        : _engine(std::make_unique<vulkan_engine>())
+    vulkan_window::vulkan_window(const uint32_t width, const uint32_t height, const engine_settings& settings)
+        : _engine(std::make_unique<vulkan_engine>(settings))
+        , _main_thread_id(std::this_thread::get_id())
+        , _frame_pacer(settings.max_frame_rate, settings.is_on_demand_rendering_enabled)
     {
         glfwInit();
 
@@ -21,6 +27,8 @@ namespace owl
         _window = glfwCreateWindow(width, height, "Owl Engine", nullptr, nullptr);
         glfwSetWindowUserPointer(_window, this);
         glfwSetFramebufferSizeCallback(_window, framebuffer_resize_callback);
+        glfwSetWindowRefreshCallback(_window, window_refresh_callback);
+        glfwSetKeyCallback(_window, key_callback);
 
         uint32_t glfw_extensions_count = 0;
         const char** glfw_extensions;
@@ -30,7 +38,11 @@ namespace owl
         _engine->create_instance(std::move(extensions));
 
         VkSurfaceKHR vk_surface;
-        auto result = glfwCreateWindowSurface(_engine->get_instance().get_vk_handle(), _window, nullptr, &vk_surface);
+        const auto& instance = _engine->get_instance();
+        auto result = glfwCreateWindowSurface(instance.get_vk_handle(),
+                                              _window,
+                                              instance.get_allocation_callbacks(vulkan::core::host_object_type::surface),
+                                              &vk_surface);
         vulkan::helpers::handle_result(result, "Failed to create window surface");
         _engine->set_vk_surface(vk_surface);
 
@@ -38,6 +50,12 @@ namespace owl
         auto texture = load_image(texture_path);
 
         _engine->initialize(width, height, std::move(mesh), std::move(texture));
+
+        int framebuffer_width = 0;
+        int framebuffer_height = 0;
+        glfwGetFramebufferSize(_window, &framebuffer_width, &framebuffer_height);
+        _framebuffer_width = framebuffer_width;
+        _framebuffer_height = framebuffer_height;
     }
 
     vulkan_window::~vulkan_window()
@@ -50,35 +68,353 @@ namespace owl
     void vulkan_window::framebuffer_resize_callback(GLFWwindow* window, int width, int height)
     {
         auto application = reinterpret_cast<vulkan_window*>(glfwGetWindowUserPointer(window));
+        application->_framebuffer_width = width;
+        application->_framebuffer_height = height;
         application->_engine->set_framebuffer_resized(true);
+        application->_frame_pacer.request_redraw();
+    }
+
+    void vulkan_window::window_refresh_callback(GLFWwindow* window)
+    {
+        auto application = reinterpret_cast<vulkan_window*>(glfwGetWindowUserPointer(window));
+        application->_frame_pacer.request_redraw();
+    }
+
+    void vulkan_window::key_callback(GLFWwindow* window, int key, int scancode, int action, int modifiers)
+    {
+        // space pauses the animation, which lets an on demand window go idle
+        auto application = reinterpret_cast<vulkan_window*>(glfwGetWindowUserPointer(window));
+        if (key == GLFW_KEY_SPACE && action == GLFW_PRESS)
+            application->_simulation.set_paused(!application->_simulation.is_paused());
     }
 
     void vulkan_window::run()
     {
-        while (!glfwWindowShouldClose(_window))
+        // the main thread owns the window events, so it samples input and runs the simulation, while a dedicated thread
+        // renders the latest published snapshot; simulating frame N+1 overlaps recording and submitting frame N
+        simulate();
+        _is_rendering = true;
+        std::thread render_thread(&vulkan_window::run_render_thread, this);
+
+        auto next_tick = std::chrono::steady_clock::now();
+        while (!glfwWindowShouldClose(_window) && _is_rendering)
         {
-            glfwPollEvents();
-            auto success = _engine->acquire_image();
-            if (success)
-                success &= _engine->draw_image();
+            // with nothing animating, an on demand window sleeps in the event loop instead of ticking
+            if (_frame_pacer.is_on_demand() && _simulation.is_paused())
+                glfwWaitEventsTimeout(idle_events_timeout);
+            else
+                glfwPollEvents();
 
-            if (!success)
+            simulate();
+
+            // a late tick is not caught up, the next snapshot simply samples a later time
+            next_tick = std::max(next_tick + simulation_tick, std::chrono::steady_clock::now());
+            std::this_thread::sleep_until(next_tick);
+        }
+
+        _is_rendering = false;
+        _frame_pacer.notify();
+        render_thread.join();
+
+        _engine->wait_idle();
+
+        if (_render_exception != nullptr)
+            std::rethrow_exception(_render_exception);
+
+        if (_engine->get_settings().is_latency_measurement_enabled)
+            display_latency_statistics();
+
+        if (!_engine->get_settings().latency_log_path.empty())
+        {
+            std::ofstream latency_log(_engine->get_settings().latency_log_path, std::ios::trunc);
+            _engine->write_frame_latencies(latency_log);
+        }
+
+        if (_frame_pacer.is_pacing())
+            display_frame_pacing_statistics();
+    }
+
+    void vulkan_window::simulate()
+    {
+        _simulation.update(_frame_states.get_write_buffer(), std::chrono::steady_clock::now());
+        _frame_states.publish();
+        _frame_pacer.notify();
+    }
+
+    void vulkan_window::run_render_thread()
+    {
+        try
+        {
+            while (_is_rendering)
             {
-                int width = 0;
-                int height = 0;
+                _frame_states.update();
+                const auto& state = _frame_states.get_read_buffer();
+                if (!_frame_pacer.begin_frame(state.content_version))
+                    continue;
 
-                glfwGetFramebufferSize(_window, &width, &height);
-                while (width == 0 || height == 0)
-                {
-                    glfwGetFramebufferSize(_window, &width, &height);
-                    glfwWaitEvents();
-                }
+                // a recreated swapchain has not presented the snapshot yet
+                if (render_frame())
+                    _frame_pacer.request_redraw();
+
+                _frame_pacer.end_frame();
+            }
+        }
+        catch (...)
+        {
+            _render_exception = std::current_exception();
+            _is_rendering = false;
+        }
+    }
+
+    void vulkan_window::run_resize_storm(uint32_t resizes_count)
+    {
+        // resizes are driven from the main thread, so the storm simulates and renders serially there
+        const int max_frames_per_resize = 120;
+        const int size_step = 64;
+
+        int base_width = 0;
+        int base_height = 0;
+        glfwGetWindowSize(_window, &base_width, &base_height);
+
+        std::chrono::microseconds total_hitch{0};
+        std::chrono::microseconds max_hitch{0};
+        uint32_t measured_resizes_count = 0;
+
+        for (uint32_t i = 0; i < resizes_count && !glfwWindowShouldClose(_window); ++i)
+        {
+            int offset = (i % 2 == 0) ? size_step : 0;
+            auto start_time = std::chrono::steady_clock::now();
+            glfwSetWindowSize(_window, base_width + offset, base_height + offset);
+
+            // the hitch lasts from the resize request until a frame has been presented with the recreated swapchain
+            bool is_recreated = false;
+            for (int frame = 0; frame < max_frames_per_resize && !is_recreated; ++frame)
+                is_recreated = render_next_frame();
+
+            if (!is_recreated)
+                continue;
+
+            render_next_frame();
+
+            auto hitch = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time);
+            total_hitch += hitch;
+            max_hitch = std::max(max_hitch, hitch);
+            measured_resizes_count++;
+        }
+
+        _engine->wait_idle();
+
+        auto statistics = _engine->get_swapchain_recreation_statistics();
+        auto to_milliseconds = [](std::chrono::microseconds duration) { return duration.count() / 1000.0; };
+        std::chrono::microseconds average_hitch{0};
+        if (measured_resizes_count > 0)
+            average_hitch = total_hitch / static_cast<int64_t>(measured_resizes_count);
+
+        std::chrono::microseconds average_recreation{0};
+        if (statistics.recreations_count > 0)
+            average_recreation = statistics.total_duration / static_cast<int64_t>(statistics.recreations_count);
+
+        std::cout << "Resize storm: " << measured_resizes_count << "/" << resizes_count << " resizes measured" << std::endl;
+        std::cout << "Hitch per resize: average " << to_milliseconds(average_hitch) << " ms, max " << to_milliseconds(max_hitch) << " ms"
+                  << std::endl;
+        std::cout << "Swapchain recreation: average " << to_milliseconds(average_recreation) << " ms, max "
+                  << to_milliseconds(statistics.max_duration) << " ms" << std::endl;
+    }
+
+    void vulkan_window::run_sharing_benchmark(uint32_t frames_count)
+    {
+        if (!_engine->has_separate_presentation_family())
+        {
+            std::cout << "Graphics and presentation share a queue family, swapchain images are always exclusive" << std::endl;
+            return;
+        }
 
-                _engine->recreate_swapchain(width, height);
+        auto exclusive_frame_time = measure_frame_time(false, frames_count);
+        auto concurrent_frame_time = measure_frame_time(true, frames_count);
+
+        auto to_milliseconds = [](std::chrono::microseconds duration) { return duration.count() / 1000.0; };
+        std::cout << "Presentation mode: " << to_string(_engine->get_presentation_mode()) << ", " << frames_count << " frames per mode"
+                  << std::endl;
+        std::cout << "Exclusive with ownership transfer: average " << to_milliseconds(exclusive_frame_time) << " ms per frame"
+                  << std::endl;
+        std::cout << "Concurrent: average " << to_milliseconds(concurrent_frame_time) << " ms per frame" << std::endl;
+    }
+
+    void vulkan_window::run_descriptor_benchmark(uint32_t draws_count)
+    {
+        std::cout << "Rendering with " << to_string(_engine->get_descriptor_binding_mode())
+                  << (_engine->is_bindless_enabled() ? " and bindless textures" : "") << ", " << draws_count << " draws per mode"
+                  << std::endl;
+
+        auto binding_modes = {descriptor_binding_mode::descriptor_sets,
+                              descriptor_binding_mode::update_templates,
+                              descriptor_binding_mode::push_descriptors};
+        for (auto binding_mode : binding_modes)
+        {
+            if (!_engine->is_descriptor_binding_mode_supported(binding_mode))
+            {
+                std::cout << "Updating with " << to_string(binding_mode) << ": not supported by the device" << std::endl;
+                continue;
             }
+
+            auto update_cost = _engine->measure_descriptor_update_cost(binding_mode, draws_count);
+            std::cout << "Updating with " << to_string(binding_mode) << ": " << update_cost.count() << " ns per draw" << std::endl;
         }
+    }
+
+    void vulkan_window::run_allocation_benchmark(uint32_t allocations_count)
+    {
+        auto result = _engine->measure_allocation_throughput(allocations_count);
+        const auto& statistics = result.statistics;
+
+        auto to_megabytes = [](VkDeviceSize size) { return size / (1024.0 * 1024.0); };
+        std::cout << "Allocation benchmark: " << allocations_count << " allocations" << std::endl;
+        std::cout << "Sub-allocation: " << result.allocation_cost.count() << " ns per allocation, " << result.free_cost.count()
+                  << " ns per free" << std::endl;
+        std::cout << "One device allocation each: " << result.device_allocation_cost.count() << " ns per allocation and free"
+                  << std::endl;
+        std::cout << "After churn: " << statistics.allocations_count << " allocations in " << statistics.blocks_count << " blocks, "
+                  << statistics.device_allocations_count << " device allocations made" << std::endl;
+        std::cout << "Used " << to_megabytes(statistics.used_size) << " MiB of " << to_megabytes(statistics.reserved_size)
+                  << " MiB reserved, largest free range " << to_megabytes(statistics.largest_free_range) << " MiB, fragmentation "
+                  << statistics.fragmentation << std::endl;
+    }
+
+    void vulkan_window::run_upload_benchmark(uint32_t uploads_count)
+    {
+        const VkDeviceSize upload_size = 256 * 1024;
+
+        if (!_engine->is_unified_memory())
+            std::cout << "Device local memory is not host visible, both modes stage their uploads" << std::endl;
+
+        auto staged_cost = _engine->measure_upload_cost(false, uploads_count, upload_size);
+        auto direct_cost = _engine->measure_upload_cost(true, uploads_count, upload_size);
+
+        auto to_microseconds = [](std::chrono::nanoseconds duration) { return duration.count() / 1000.0; };
+        std::cout << "Upload benchmark: " << uploads_count << " vertex buffers of " << upload_size / 1024 << " KiB per mode" << std::endl;
+        std::cout << "Staged: " << to_microseconds(staged_cost) << " us per upload" << std::endl;
+        std::cout << "Direct write: " << to_microseconds(direct_cost) << " us per upload" << std::endl;
+    }
+
+    void vulkan_window::run_defragmentation_soak(uint32_t frames_count)
+    {
+        const uint32_t samples_count = 16;
+
+        auto samples = _engine->run_defragmentation_soak(frames_count, samples_count);
+
+        auto to_megabytes = [](VkDeviceSize size) { return size / (1024.0 * 1024.0); };
+        VkDeviceSize max_reserved_size = 0;
+        std::cout << "Defragmentation soak: " << frames_count << " frames" << std::endl;
+        for (const auto& sample : samples)
+        {
+            max_reserved_size = std::max(max_reserved_size, sample.reserved_size);
+            std::cout << "Frame " << sample.frame << ": used " << to_megabytes(sample.used_size) << " MiB, reserved "
+                      << to_megabytes(sample.reserved_size) << " MiB in " << sample.blocks_count << " blocks, fragmentation "
+                      << sample.fragmentation << ", " << sample.moves_count << " moves" << std::endl;
+        }
+
+        std::cout << "Peak reserved: " << to_megabytes(max_reserved_size) << " MiB" << std::endl;
+    }
+
+    std::chrono::microseconds vulkan_window::measure_frame_time(bool is_concurrent_sharing, uint32_t frames_count)
+    {
+        // the benchmark renders serially on the main thread, like the resize storm
+        const int warm_up_frames_count = 16;
 
+        auto settings = _engine->get_settings();
+        settings.is_concurrent_swapchain_sharing_enabled = is_concurrent_sharing;
+        _engine->set_settings(settings);
+
+        // the first frames recreate the swapchain with the new sharing mode
+        for (int i = 0; i < warm_up_frames_count && !glfwWindowShouldClose(_window); ++i)
+            render_next_frame();
+        _engine->wait_idle();
+
+        uint32_t rendered_frames_count = 0;
+        auto start_time = std::chrono::steady_clock::now();
+        for (; rendered_frames_count < frames_count && !glfwWindowShouldClose(_window); ++rendered_frames_count)
+            render_next_frame();
         _engine->wait_idle();
+
+        if (rendered_frames_count == 0)
+            return std::chrono::microseconds{0};
+
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time);
+        return duration / static_cast<int64_t>(rendered_frames_count);
+    }
+
+    bool vulkan_window::render_next_frame()
+    {
+        glfwPollEvents();
+        simulate();
+
+        return render_frame();
+    }
+
+    bool vulkan_window::render_frame()
+    {
+        auto latch_state = [this]() -> const frame_state& {
+            _frame_states.update();
+            return _frame_states.get_read_buffer();
+        };
+
+        auto success = _engine->acquire_image();
+        if (success)
+            success &= _engine->draw_image(latch_state);
+
+        if (success)
+            return false;
+
+        // a minimized window has no framebuffer, wait until it is restored
+        while (_framebuffer_width == 0 || _framebuffer_height == 0)
+        {
+            if (std::this_thread::get_id() == _main_thread_id)
+                glfwWaitEvents();
+            else if (_is_rendering)
+                std::this_thread::sleep_for(simulation_tick);
+            else
+                return false;
+        }
+
+        _engine->recreate_swapchain(_framebuffer_width, _framebuffer_height);
+
+        return true;
+    }
+
+    void vulkan_window::display_latency_statistics()
+    {
+        auto statistics = _engine->get_latency_statistics();
+        auto to_milliseconds = [](std::chrono::microseconds duration) { return duration.count() / 1000.0; };
+
+        std::cout << "Presentation mode: " << to_string(_engine->get_presentation_mode())
+                  << ", frames in flight: " << _engine->get_settings().frames_in_flight << std::endl;
+        std::cout << "Input to submit: average " << to_milliseconds(statistics.average_submit_latency) << " ms, max "
+                  << to_milliseconds(statistics.max_submit_latency) << " ms" << std::endl;
+        std::cout << "Input to present: average " << to_milliseconds(statistics.average_present_latency) << " ms, max "
+                  << to_milliseconds(statistics.max_present_latency) << " ms" << std::endl;
+        std::cout << "Input to gpu completion: average " << to_milliseconds(statistics.average_completion_latency) << " ms, max "
+                  << to_milliseconds(statistics.max_completion_latency) << " ms (" << statistics.samples_count << " samples)"
+                  << std::endl;
+    }
+
+    void vulkan_window::display_frame_pacing_statistics()
+    {
+        auto statistics = _frame_pacer.get_statistics();
+        auto to_milliseconds = [](std::chrono::microseconds duration) { return duration.count() / 1000.0; };
+        auto to_percentage = [&statistics](std::chrono::microseconds duration) {
+            return statistics.elapsed_time.count() > 0 ? 100.0 * duration.count() / statistics.elapsed_time.count() : 0.0;
+        };
+
+        std::chrono::microseconds average_render_time{0};
+        if (statistics.rendered_frames_count > 0)
+            average_render_time = statistics.render_time / static_cast<int64_t>(statistics.rendered_frames_count);
+
+        std::cout << "Frames: " << statistics.rendered_frames_count << " rendered, " << statistics.skipped_frames_count
+                  << " skipped in " << to_milliseconds(statistics.elapsed_time) << " ms" << std::endl;
+        std::cout << "Frame time: average " << to_milliseconds(average_render_time) << " ms, render thread busy "
+                  << to_percentage(statistics.render_time) << " %" << std::endl;
+        std::cout << "Render thread idle: " << to_milliseconds(statistics.limiter_wait_time) << " ms in the frame limiter, "
+                  << to_milliseconds(statistics.idle_time) << " ms waiting for changes" << std::endl;
     }
 
     texture vulkan_window::load_image(const std::string& path)
@@ -3,10 +3,19 @@
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
 
+#include <atomic>
+#include <chrono>
+#include <exception>
 #include <memory>
+#include <thread>
 
+#include <engine_settings.h>
+#include <frame_pacer.h>
+#include <frame_state.h>
 #include <mesh.h>
+#include <simulation.h>
 #include <texture.h>
+#include <triple_buffer.h>
 
 #include "vulkan_engine.h"
 
@@ -15,21 +24,49 @@ namespace owl
     class vulkan_window
     {
     public:
-        vulkan_window(const uint32_t width, const uint32_t height);
+        vulkan_window(const uint32_t width, const uint32_t height, const engine_settings& settings = engine_settings());
         ~vulkan_window();
 
         void run();
+        void run_resize_storm(uint32_t resizes_count);
+        void run_sharing_benchmark(uint32_t frames_count);
+        void run_descriptor_benchmark(uint32_t draws_count);
+        void run_allocation_benchmark(uint32_t allocations_count);
+        void run_upload_benchmark(uint32_t uploads_count);
+        void run_defragmentation_soak(uint32_t frames_count);
 
         static void framebuffer_resize_callback(GLFWwindow* window, int width, int height);
+        static void window_refresh_callback(GLFWwindow* window);
+        static void key_callback(GLFWwindow* window, int key, int scancode, int action, int modifiers);
 
     private:
         const std::string model_path = "resources/models/viking_room.obj";
         const std::string texture_path = "resources/textures/viking_room.png";
+        const std::chrono::microseconds simulation_tick{4000};
+        // how long an idle on demand window waits for input before simulating again
+        const double idle_events_timeout = 0.25;
 
         GLFWwindow* _window;
         std::unique_ptr<vulkan_engine> _engine;
-        bool _framebuffer_resized = false;
+        std::thread::id _main_thread_id;
 
+        // glfw only reports the framebuffer size on the main thread, the render thread reads it from here
+        std::atomic<int> _framebuffer_width{0};
+        std::atomic<int> _framebuffer_height{0};
+
+        simulation _simulation;
+        triple_buffer<frame_state> _frame_states;
+        frame_pacer _frame_pacer;
+        std::atomic<bool> _is_rendering{false};
+        std::exception_ptr _render_exception;
+
+        void simulate();
+        void run_render_thread();
+        bool render_frame();
+        bool render_next_frame();
+        std::chrono::microseconds measure_frame_time(bool is_concurrent_sharing, uint32_t frames_count);
+        void display_latency_statistics();
+        void display_frame_pacing_statistics();
         texture load_image(const std::string& path);
         mesh load_model(const std::string& path);
     };